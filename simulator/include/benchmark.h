@@ -0,0 +1,210 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "parameter_parser.h"
+#include "simulator_state.h"
+
+// Call the main file after mocks
+#include "src/system/global.h"
+
+// see LMBD_LAMP_TYPE__${UPPER_SIM_NAME} hard-coded in simulator/Makefile
+#include "src/user/constants.h"
+
+#include "src/user/functions.h"
+#include "src/system/platform/time.h"
+
+#include "simulator/include/hardware_influencer.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+//
+// mode benchmark: run reset + loop of every mode for a fixed number of
+// virtual ticks, and write a csv table with one line per mode:
+//  - group, mode: mode indexes
+//  - frames: number of loop calls
+//  - ns_per_frame, max_ns_per_frame: host time of a loop call (average & worst)
+//  - allocations, allocated_bytes: heap allocations during reset & loops
+//  - switch_allocations: heap allocations while switching to the mode (must be 0)
+//  - peak_stack_bytes: deepest stack use of reset & loops (stack painting)
+//  - state_bytes: size of the mode state, in the shared mode state arena
+//
+
+namespace benchmark {
+
+// heap allocation counters, updated by the operator new of benchmark_allocations.cpp
+struct AllocationStats
+{
+  bool isCounting = false;
+  uint64_t count = 0;
+  uint64_t bytes = 0;
+};
+extern AllocationStats allocations;
+
+// stack area painted below the benchmark frame
+static constexpr size_t stackPaintSize = 256 * 1024;
+static constexpr uint8_t stackPaintValue = 0xa5;
+
+// paint the stack area below the caller frame, return its lowest address
+__attribute__((noinline)) static uintptr_t paint_stack()
+{
+  volatile uint8_t area[stackPaintSize];
+  for (size_t i = 0; i < stackPaintSize; ++i)
+  {
+    area[i] = stackPaintValue;
+  }
+  return reinterpret_cast<uintptr_t>(&area[0]);
+}
+
+// number of bytes used below \p top since the call to paint_stack
+__attribute__((noinline)) static size_t measure_stack(const uintptr_t bottom, const uintptr_t top)
+{
+  const volatile uint8_t* it = reinterpret_cast<const volatile uint8_t*>(bottom);
+  while (reinterpret_cast<uintptr_t>(it) < top and *it == stackPaintValue)
+  {
+    ++it;
+  }
+  return top - reinterpret_cast<uintptr_t>(it);
+}
+
+struct ModeResult
+{
+  uint32_t frames = 0;
+  uint64_t totalNs = 0;
+  uint64_t maxNs = 0;
+  uint64_t allocations = 0;
+  uint64_t allocatedBytes = 0;
+  uint64_t switchAllocations = 0;
+  size_t peakStack = 0;
+};
+
+__attribute__((noinline)) static ModeResult run_mode(const uint8_t group, const uint8_t mode, const uint32_t ticks)
+{
+  using clock = std::chrono::steady_clock;
+  ModeResult result;
+
+  const uintptr_t stackTop = reinterpret_cast<uintptr_t>(__builtin_frame_address(0));
+  const uintptr_t stackBottom = paint_stack();
+
+  allocations = {true, 0, 0};
+  user::_private::select_mode(group, mode);
+  result.switchAllocations = allocations.count;
+  for (uint32_t tick = 0; tick < ticks; ++tick)
+  {
+    // the virtual time advances as in the main loop regulation
+    delay_ms(MAIN_LOOP_UPDATE_PERIOD_MS);
+
+    const auto start = clock::now();
+    user::loop();
+    const uint64_t duration = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count();
+
+    result.totalNs += duration;
+    result.maxNs = std::max(result.maxNs, duration);
+    result.frames += 1;
+  }
+  allocations.isCounting = false;
+
+  result.allocations = allocations.count;
+  result.allocatedBytes = allocations.bytes;
+  result.peakStack = measure_stack(stackBottom, stackTop);
+  return result;
+}
+
+struct parameters
+{
+  uint32_t ticks = 1000;                    // loop calls per mode
+  const char* outputPath = "benchmark.csv"; // where to write the table
+  const char* wavPath = nullptr;            // microphone input (default: computer microphone)
+
+  // parse "[ticks] [outputPath] [wavPath]", return false if malformed
+  bool parse(int argc, char** argv)
+  {
+    if (argc > 4)
+      return false;
+    if (argc > 1)
+      ticks = strtoul(argv[1], nullptr, 10);
+    if (argc > 2)
+      outputPath = argv[2];
+    if (argc > 3)
+      wavPath = argv[3];
+    return ticks > 0;
+  }
+};
+
+static int run(int argc, char** argv)
+{
+  parameters params;
+  if (not params.parse(argc, argv))
+  {
+    fprintf(stderr, "usage: %s [ticks] [outputPath] [wavPath]\n", argv[0]);
+    return 1;
+  }
+
+  if (params.wavPath != nullptr and not mock_microphone::set_wav_source(params.wavPath))
+  {
+    fprintf(stderr, "unable to read %s\n", params.wavPath);
+    return 1;
+  }
+
+  FILE* output = fopen(params.outputPath, "w");
+  if (output == nullptr)
+  {
+    fprintf(stderr, "unable to open %s\n", params.outputPath);
+    return 1;
+  }
+
+  sim::globals::state.isVirtualTime = true;
+
+  // load initial values
+  read_and_update_parameters();
+
+  // Main program setup, then light the lamp
+  global::main_setup();
+  user::power_on_sequence();
+
+  fprintf(output, "group,mode,frames,ns_per_frame,max_ns_per_frame,allocations,allocated_bytes,switch_allocations,peak_stack_bytes,state_bytes\n");
+
+  // modes that allocate when switched to (their state is rebuilt on each switch)
+  uint32_t allocatingSwitches = 0;
+
+  const uint8_t groupCount = user::_private::get_groups_count();
+  for (uint8_t group = 0; group < groupCount; ++group)
+  {
+    const uint8_t modeCount = user::_private::get_modes_count(group);
+    for (uint8_t mode = 0; mode < modeCount; ++mode)
+    {
+      const ModeResult result = run_mode(group, mode, params.ticks);
+      fprintf(output,
+              "%u,%u,%u,%llu,%llu,%llu,%llu,%llu,%zu,%zu\n",
+              group,
+              mode,
+              result.frames,
+              static_cast<unsigned long long>(result.totalNs / result.frames),
+              static_cast<unsigned long long>(result.maxNs),
+              static_cast<unsigned long long>(result.allocations),
+              static_cast<unsigned long long>(result.allocatedBytes),
+              static_cast<unsigned long long>(result.switchAllocations),
+              result.peakStack,
+              user::_private::get_mode_state_size(group, mode));
+
+      if (result.switchAllocations > 0)
+      {
+        fprintf(stderr,
+                "group %u mode %u: %llu allocations on mode switch\n",
+                group,
+                mode,
+                static_cast<unsigned long long>(result.switchAllocations));
+        allocatingSwitches += 1;
+      }
+    }
+  }
+
+  fclose(output);
+  fprintf(stderr, "benchmark written to %s\n", params.outputPath);
+  return (allocatingSwitches == 0) ? 0 : 1;
+}
+
+} // namespace benchmark
+
+#endif
@@ -0,0 +1,162 @@
+#ifndef COLORS_CHECK_H
+#define COLORS_CHECK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+// see LMBD_LAMP_TYPE__${UPPER_SIM_NAME} hard-coded in simulator/Makefile
+#include "src/system/colors/palettes.h"
+#include "src/modes/include/colors/utils.hpp"
+
+//
+// colors check: compare the integer palette lookups (LMBD_FIXED_POINT_COLORS)
+// to their float versions, on random palettes, every index and brightness:
+//  - get_color_from_palette, with 8 and 16 bit indexes
+//  - modes::colors::from_palette, with 8 and 16 bit indexes, looping or not
+//
+// Prints the first mismatches, and returns 1 if any result differs.
+//
+
+namespace colors_check {
+
+/// Float versions, built without LMBD_FIXED_POINT_COLORS (colors_check_reference.cpp)
+namespace reference {
+
+uint32_t get_color_from_palette(const uint8_t index, const palette_t& palette, const uint8_t brightness);
+uint32_t get_color_from_palette(const uint16_t index, const palette_t& palette, const uint8_t brightness);
+
+uint32_t from_palette(uint8_t index, const modes::colors::PaletteTy& palette, uint8_t brightness, bool loops);
+uint32_t from_palette(uint16_t index, const modes::colors::PaletteTy& palette, uint8_t brightness, bool loops);
+
+} // namespace reference
+
+// count mismatches, print the first ones
+struct Report
+{
+  const char* name;
+  uint64_t checked = 0;
+  uint64_t mismatches = 0;
+
+  void compare(const uint32_t index, const uint8_t brightness, const uint32_t expected, const uint32_t result)
+  {
+    checked += 1;
+    if (expected == result)
+      return;
+
+    if (mismatches < 8)
+    {
+      fprintf(stderr,
+              "%s: index %u brightness %u: expected %08x, got %08x\n",
+              name,
+              index,
+              brightness,
+              expected,
+              result);
+    }
+    mismatches += 1;
+  }
+};
+
+// deterministic palettes (xorshift), alpha byte included
+static palette_t random_palette(uint32_t& seed)
+{
+  palette_t palette;
+  for (uint32_t& entry: palette)
+  {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    entry = seed;
+  }
+  return palette;
+}
+
+static void check_palette(const palette_t& palette, Report (&reports)[6])
+{
+  for (uint32_t brightness = 0; brightness < 256; ++brightness)
+  {
+    for (uint32_t index = 0; index < 256; ++index)
+    {
+      reports[0].compare(index,
+                         brightness,
+                         reference::get_color_from_palette(uint8_t(index), palette, brightness),
+                         get_color_from_palette(uint8_t(index), palette, brightness));
+      reports[1].compare(index,
+                         brightness,
+                         reference::from_palette(uint8_t(index), palette, brightness, true),
+                         modes::colors::from_palette<true>(uint8_t(index), palette, brightness));
+      reports[2].compare(index,
+                         brightness,
+                         reference::from_palette(uint8_t(index), palette, brightness, false),
+                         modes::colors::from_palette<false>(uint8_t(index), palette, brightness));
+    }
+  }
+
+  // 16 bit indexes, on a few brightness levels
+  for (const uint8_t brightness: {0, 1, 127, 254, 255})
+  {
+    for (uint32_t index = 0; index <= UINT16_MAX; ++index)
+    {
+      reports[3].compare(index,
+                         brightness,
+                         reference::get_color_from_palette(uint16_t(index), palette, brightness),
+                         get_color_from_palette(uint16_t(index), palette, brightness));
+      reports[4].compare(index,
+                         brightness,
+                         reference::from_palette(uint16_t(index), palette, brightness, true),
+                         modes::colors::from_palette<true, uint16_t>(index, palette, brightness));
+      reports[5].compare(index,
+                         brightness,
+                         reference::from_palette(uint16_t(index), palette, brightness, false),
+                         modes::colors::from_palette<false, uint16_t>(index, palette, brightness));
+    }
+  }
+}
+
+static int run(int argc, char** argv)
+{
+  uint32_t paletteCount = 100;
+  if (argc > 2 or (argc == 2 and (paletteCount = strtoul(argv[1], nullptr, 10)) == 0))
+  {
+    fprintf(stderr, "usage: %s [paletteCount]\n", argv[0]);
+    return 1;
+  }
+
+#ifndef LMBD_FIXED_POINT_COLORS
+  fprintf(stderr, "LMBD_FIXED_POINT_COLORS is not defined, only float versions are compared\n");
+#endif
+
+  Report reports[6] = {{"get_color_from_palette<u8>"},
+                       {"from_palette<u8, loops>"},
+                       {"from_palette<u8>"},
+                       {"get_color_from_palette<u16>"},
+                       {"from_palette<u16, loops>"},
+                       {"from_palette<u16>"}};
+
+  // plain palettes first, then random ones
+  check_palette(palette_t {}, reports);
+  check_palette(PaletteRainbowColors, reports);
+
+  uint32_t seed = 0x4c4d4244;
+  for (uint32_t i = 0; i < paletteCount; ++i)
+  {
+    check_palette(random_palette(seed), reports);
+  }
+
+  uint64_t mismatches = 0;
+  for (const Report& report: reports)
+  {
+    printf("%s: %llu mismatches over %llu lookups\n",
+           report.name,
+           static_cast<unsigned long long>(report.mismatches),
+           static_cast<unsigned long long>(report.checked));
+    mismatches += report.mismatches;
+  }
+  return (mismatches == 0) ? 0 : 1;
+}
+
+} // namespace colors_check
+
+#endif
@@ -2,6 +2,7 @@
 #define HARDWARE_INFLUENCER_H
 
 #include <cstdint>
+#include <vector>
 
 namespace mock_gpios {
 // update gpios callbacks
@@ -25,4 +26,19 @@ namespace mock_battery {
 extern float voltage;
 }
 
+namespace mock_led_output {
+// frames transfered to the strip since the start
+extern uint32_t frameCount;
+// transfers that had to wait for the previous one to complete
+extern uint32_t fenceWaitCount;
+// last frame transfered to the strip (wire format)
+const std::vector<uint8_t>& get_last_frame();
+} // namespace mock_led_output
+
+namespace mock_microphone {
+// read the microphone samples from a PCM 16 bits WAV file (looped, synchronized
+// to the simulation time) instead of the computer microphone, false if unreadable
+bool set_wav_source(const char* path);
+} // namespace mock_microphone
+
 #endif
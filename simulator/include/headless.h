@@ -0,0 +1,132 @@
+#ifndef HEADLESS_H
+#define HEADLESS_H
+
+#include "parameter_parser.h"
+#include "simulator_state.h"
+
+// Call the main file after mocks
+#include "src/system/global.h"
+
+// see LMBD_LAMP_TYPE__${UPPER_SIM_NAME} hard-coded in simulator/Makefile
+#include "src/user/constants.h"
+
+#include "src/user/functions.h"
+#include "src/system/utils/utils.h"
+
+#include "simulator/include/hardware_influencer.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+//
+// headless simulator: no window, virtual time, frames dumped to a file
+//
+// Output file format (little endian):
+//  - header: "LMBD" magic, uint32 LED count
+//  - then for each frame: uint32 time (ms), uint32 brightness, LED count * uint32 colors (0xWWRRGGBB)
+//
+
+struct headlessParameters
+{
+  uint32_t frameCount = 1000;            // number of main loops to run
+  const char* outputPath = "frames.bin"; // where to dump the frames
+  uint8_t clickCount = 1;                // button clicks sent at startup (1 click: turn on)
+  const char* wavPath = nullptr;         // microphone input (default: computer microphone)
+
+  // parse "[frameCount] [outputPath] [clickCount] [wavPath]", return false if malformed
+  bool parse(int argc, char** argv)
+  {
+    if (argc > 5)
+      return false;
+    if (argc > 1)
+      frameCount = strtoul(argv[1], nullptr, 10);
+    if (argc > 2)
+      outputPath = argv[2];
+    if (argc > 3)
+      clickCount = strtoul(argv[3], nullptr, 10);
+    if (argc > 4)
+      wavPath = argv[4];
+    return frameCount > 0;
+  }
+};
+
+struct headless
+{
+  // main loops spent with the button pressed, then released, for each click
+  static constexpr uint32_t clickLoopCount = 4;
+
+  static int run(int argc, char** argv)
+  {
+    headlessParameters params;
+    if (not params.parse(argc, argv))
+    {
+      fprintf(stderr, "usage: %s [frameCount] [outputPath] [clickCount] [wavPath]\n", argv[0]);
+      return 1;
+    }
+
+    if (params.wavPath != nullptr and not mock_microphone::set_wav_source(params.wavPath))
+    {
+      fprintf(stderr, "unable to read %s\n", params.wavPath);
+      return 1;
+    }
+
+    FILE* output = fopen(params.outputPath, "wb");
+    if (output == nullptr)
+    {
+      fprintf(stderr, "unable to open %s\n", params.outputPath);
+      return 1;
+    }
+
+    // reference to global state
+    auto& state = sim::globals::state;
+    state.isVirtualTime = true;
+
+    // load initial values
+    read_and_update_parameters();
+
+    // Main program setup
+    global::main_setup();
+
+    const uint32_t ledCount = LED_COUNT;
+    fwrite("LMBD", 1, 4, output);
+    fwrite(&ledCount, sizeof(ledCount), 1, output);
+
+    const uint32_t clickEnd = params.clickCount * clickLoopCount * 2;
+    uint32_t frame = 0;
+    for (uint32_t loop = 0; frame < params.frameCount; ++loop)
+    {
+      // deep sleep, exit
+      if (mock_registers::isDeepSleep)
+        break;
+
+      // startup button clicks
+      state.isButtonPressed = loop < clickEnd and (loop / clickLoopCount) % 2 == 0;
+      mock_gpios::update_callbacks();
+
+      // main program loop (time only advances in the loop regulation)
+      global::main_loop(mock_registers::addedAlgoDelay);
+
+      // start recording once the clicks are done
+      if (loop < clickEnd)
+        continue;
+
+      for (size_t I = 0; I < LED_COUNT; ++I)
+      {
+        state.colorBuffer[I] = user::_private::strip.getPixelColor(I);
+      }
+      state.brightness = user::_private::strip.getBrightness();
+
+      const uint32_t frameHeader[2] = {time_ms(), state.brightness};
+      fwrite(frameHeader, sizeof(uint32_t), 2, output);
+      fwrite(state.colorBuffer, sizeof(uint32_t), LED_COUNT, output);
+      ++frame;
+    }
+
+    fclose(output);
+    fprintf(stderr, "%u frames written to %s\n", frame, params.outputPath);
+    return 0;
+  }
+};
+
+#endif
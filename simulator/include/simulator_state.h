@@ -20,6 +20,9 @@ struct GlobalSimStateTy
   uint32_t colorBuffer[LED_COUNT] = {};
   uint32_t indicatorColor = 0;
   float slowTimeFactor = 1.0;
+  // if set, time only advances by calls to delay_ms/delay_us (headless simulation)
+  bool isVirtualTime = false;
+  uint64_t virtualTime_us = 0;
 };
 
 extern GlobalSimStateTy state;
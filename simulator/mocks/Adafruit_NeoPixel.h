@@ -14,10 +14,18 @@ static constexpr int NEO_KHZ800 = 1;
 class Adafruit_NeoPixel
 {
 public:
-  Adafruit_NeoPixel(size_t ledCount, int16_t pin, neoPixelType type) { brightness = 255; };
+  Adafruit_NeoPixel(size_t ledCount, int16_t pin, neoPixelType type) :
+    pin(pin),
+    numLEDs(ledCount),
+    numBytes(ledCount * 3),
+    pixels(new uint8_t[ledCount * 3]())
+  {
+    brightness = 255;
+  };
 
   void begin() {}
 
+  // blocking output, only used if the asynchronous output (led_output_mock) is not available
   void show() {}
 
   uint8_t getBrightness() const { return brightness; }
@@ -29,6 +37,8 @@ public:
 
   uint32_t getPixelColor(uint16_t n) const { return 0; }
 
+  uint8_t* getPixels() const { return pixels.get(); }
+
   void clear() {};
 
   static uint32_t Color(uint8_t r, uint8_t g, uint8_t b) { return (r << 16) | (g << 8) | b; }
@@ -40,6 +50,18 @@ public:
 
   // vars
   uint8_t brightness;
+
+protected:
+  int16_t pin;
+  uint16_t numLEDs;
+  uint16_t numBytes;
+  std::unique_ptr<uint8_t[]> pixels;
+
+  // NEO_RGB layout, no white channel
+  uint8_t rOffset = 0;
+  uint8_t gOffset = 1;
+  uint8_t bOffset = 2;
+  uint8_t wOffset = 0;
 };
 
 #endif
@@ -45,91 +45,61 @@ namespace mock_battery {
 float voltage;
 } // namespace mock_battery
 
-class DigitalPinImpl
-{
-public:
-  DigitalPinImpl(DigitalPin::GPIO pin) : _pin(pin) {}
-  ~DigitalPinImpl() = default;
-
-  bool is_high()
-  {
-    // button pin
-    if (_pin == buttonPin)
-    {
-      return !mock_gpios::isButtonPressed;
-    }
-
-    return false;
-  }
-
-  void write(uint16_t value)
-  {
-    switch (_pin)
-    {
-      case RedIndicator:
-        {
-          mock_indicator::idColor.red = (value & 255);
-          break;
-        }
-      case GreenIndicator:
-        {
-          // correction value for the real luminosity
-          mock_indicator::idColor.green = (value & 255) * 7.5;
-          break;
-        }
-      case BlueIndicator:
-        {
-          mock_indicator::idColor.blue = (value & 255);
-          break;
-        }
-    }
-  }
+void DigitalPin::set_pin_mode(Mode mode) {}
 
-  uint16_t read()
+bool DigitalPin::is_high() const
+{
+  // button pin
+  if (mGpio == buttonPin)
   {
-    switch (_pin)
-    {
-    }
-    return 0;
+    return !mock_gpios::isButtonPressed;
   }
 
-  void attach_callback(voidFuncPtr cllbk) { mock_gpios::callbacks[_pin] = cllbk; }
-
-  void detach_callbacks() { mock_gpios::callbacks.erase(_pin); }
-
-public:
-  DigitalPin::GPIO _pin;
-};
-
-DigitalPin::DigitalPin(DigitalPin::GPIO pin) : mGpio(pin) { mImpl = std::make_shared<DigitalPinImpl>(pin); }
-DigitalPin::~DigitalPin() = default;
-DigitalPin::DigitalPin(const DigitalPin& other) = default;
-
-DigitalPin& DigitalPin::operator=(const DigitalPin& other) = default;
-
-void DigitalPin::set_pin_mode(Mode mode) {}
-
-bool DigitalPin::is_high() const { return mImpl->is_high(); }
+  return false;
+}
 
 void DigitalPin::set_high(bool is_high) {}
 
-void DigitalPin::write(uint16_t value) { mImpl->write(value); }
+void DigitalPin::write(uint16_t value)
+{
+  switch (mGpio)
+  {
+    case RedIndicator:
+      {
+        mock_indicator::idColor.red = (value & 255);
+        break;
+      }
+    case GreenIndicator:
+      {
+        // correction value for the real luminosity
+        mock_indicator::idColor.green = (value & 255) * 7.5;
+        break;
+      }
+    case BlueIndicator:
+      {
+        mock_indicator::idColor.blue = (value & 255);
+        break;
+      }
+    default:
+      break;
+  }
+}
 
-uint16_t DigitalPin::read() const { return mImpl->read(); }
+uint16_t DigitalPin::read() const { return 0; }
 
 int DigitalPin::pin() const { return 0; }
 
 void DigitalPin::attach_callback(voidFuncPtr func, Interrupt mode)
 {
   // TODO issue #132: handle different interrupts
-  DigitalPin::s_gpiosWithInterrupts.emplace(mGpio);
-  mImpl->attach_callback(func);
+  DigitalPin::s_gpiosWithInterrupts |= interrupt_mask(mGpio);
+  mock_gpios::callbacks[mGpio] = func;
 }
 
 void DigitalPin::detach_callbacks()
 {
-  DigitalPin::s_gpiosWithInterrupts.erase(mGpio);
-  mImpl->detach_callbacks();
+  DigitalPin::s_gpiosWithInterrupts &= ~interrupt_mask(mGpio);
+  mock_gpios::callbacks.erase(mGpio);
 }
 
 void DigitalPin::disconnect()
@@ -93,4 +93,32 @@ int i2c_xfer(
       }
   }
   return 1;
-}
\ No newline at end of file
+}
+// mock bus: the batches are run right away, on the calling thread
+int i2c_transfer(uint8_t i2cIndex, uint8_t deviceAddr, const i2c_operation* operations, uint8_t count, int stopBit)
+{
+  int result = 0;
+  for (uint8_t i = 0; i < count; ++i)
+  {
+    const i2c_operation& operation = operations[i];
+    if (operation.isWrite)
+      result |= i2c_writeData(i2cIndex, deviceAddr, operation.registerAdd, operation.size, operation.buf, stopBit);
+    else
+      result |= i2c_readData(i2cIndex, deviceAddr, operation.registerAdd, operation.size, operation.buf, stopBit);
+  }
+  return result != 0 ? 1 : 0;
+}
+
+int i2c_submit(uint8_t i2cIndex,
+               uint8_t deviceAddr,
+               const i2c_operation* operations,
+               uint8_t count,
+               int stopBit,
+               i2c_callback callback,
+               void* userData)
+{
+  if (callback == nullptr)
+    return 1;
+  callback(i2c_transfer(i2cIndex, deviceAddr, operations, count, stopBit), userData);
+  return 0;
+}
@@ -0,0 +1,64 @@
+#include "src/system/platform/led_output.h"
+
+#include "src/system/platform/time.h"
+
+#include "simulator/include/hardware_influencer.h"
+
+#include <vector>
+
+#define PLATFORM_LED_OUTPUT_CPP
+
+// fake DMA sink: keeps the transfered frames, "busy" for the duration of a real transfer
+namespace mock_led_output {
+
+uint32_t frameCount = 0;
+uint32_t fenceWaitCount = 0;
+
+static std::vector<uint8_t> sink;
+static uint32_t transferStart_us = 0;
+static uint32_t transferDuration_us = 0;
+static bool isTransfering = false;
+
+const std::vector<uint8_t>& get_last_frame() { return sink; }
+
+} // namespace mock_led_output
+
+using namespace mock_led_output;
+
+bool led_output_setup(const int16_t pin, const uint16_t frameSize)
+{
+  led_output_wait();
+  sink.assign(frameSize, 0);
+  // 1.25us per bit, then 300us of latch
+  transferDuration_us = (frameSize * 8 * 5) / 4 + 300;
+  return true;
+}
+
+bool led_output_send(const uint8_t* frame)
+{
+  if (led_output_is_busy())
+  {
+    fenceWaitCount += 1;
+    led_output_wait();
+  }
+
+  sink.assign(frame, frame + sink.size());
+  frameCount += 1;
+  transferStart_us = time_us();
+  isTransfering = true;
+  return true;
+}
+
+bool led_output_is_busy(void)
+{
+  if (isTransfering and time_us() - transferStart_us >= transferDuration_us)
+    isTransfering = false;
+  return isTransfering;
+}
+
+void led_output_wait(void)
+{
+  if (led_output_is_busy())
+    delay_us(transferDuration_us - (time_us() - transferStart_us));
+  isTransfering = false;
+}
@@ -1,10 +1,16 @@
 #include "src/system/platform/pdm_handle.h"
 
 #include "src/system/utils/utils.h"
+#include "src/system/platform/fft.h"
 #include "src/system/platform/time.h"
 
+#include "simulator/include/hardware_influencer.h"
+
 #include <SFML/Graphics/PrimitiveType.hpp>
 #include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
 
 #include <SFML/Audio/SoundRecorder.hpp>
 
@@ -15,9 +21,10 @@ class LevelRecorder : public sf::SoundRecorder
 {
   virtual bool onStart() { return true; }
 
+  // called from the recording thread, the single producer of the ring
   virtual bool onProcessSamples(const std::int16_t* samples, std::size_t sampleCount)
   {
-    data.sampleRead = 0;
+    microphone::PdmData& data = ring.write_slot();
     data.sampleDuration_us = 0; // TODO issue #132
     const size_t readCnt = min(sampleCount, microphone::PdmData::SAMPLE_SIZE);
     for (std::size_t i = 0; i < readCnt; i++)
@@ -26,29 +33,227 @@ class LevelRecorder : public sf::SoundRecorder
     }
     data.sampleTime_us = time_us();
     data.sampleRead = readCnt;
+    data.update_sum_of_squares();
+    data.sequence = ring.latest_sequence() + 1;
+    ring.publish();
     return true;
   }
 
   virtual void onStop() {}
 
 public:
-  microphone::PdmData data;
+  microphone::PdmRing ring;
   ~LevelRecorder() { stop(); }
 };
 LevelRecorder recorder;
 
+// WAV file input: publishes a block each time PdmData::SAMPLE_SIZE samples of
+// simulation time have elapsed (called by the readers, no thread involved)
+class WavSource
+{
+public:
+  bool isOpen = false;
+
+  bool open(const char* path)
+  {
+    FILE* file = fopen(path, "rb");
+    if (file == nullptr)
+      return false;
+
+    isOpen = read_wav(file);
+    fclose(file);
+    if (not isOpen)
+      fprintf(stderr, "%s: not a PCM 16 bits WAV file\n", path);
+    return isOpen;
+  }
+
+  void start()
+  {
+    nextBlockTime_us = time_us() + blockDuration_us;
+    position = 0;
+  }
+
+  // publish the blocks completed since the last update
+  void update(microphone::PdmRing& ring)
+  {
+    const uint32_t now = time_us();
+    if (static_cast<int32_t>(now - nextBlockTime_us) < 0)
+      return;
+
+    // skip the blocks that would be overwritten before being read
+    const uint32_t lateBlocks = (now - nextBlockTime_us) / blockDuration_us;
+    if (lateBlocks >= microphone::PdmRing::readableCount)
+    {
+      const uint32_t skipped = lateBlocks - microphone::PdmRing::readableCount + 1;
+      advance(skipped * microphone::PdmData::SAMPLE_SIZE);
+      nextBlockTime_us += skipped * blockDuration_us;
+    }
+
+    for (; static_cast<int32_t>(now - nextBlockTime_us) >= 0; nextBlockTime_us += blockDuration_us)
+    {
+      microphone::PdmData& data = ring.write_slot();
+      for (uint16_t i = 0; i < microphone::PdmData::SAMPLE_SIZE; i++)
+      {
+        data.data[i] = sample_at(position);
+        advance(1);
+      }
+      data.sampleDuration_us = blockDuration_us;
+      data.sampleTime_us = nextBlockTime_us;
+      data.sampleRead = microphone::PdmData::SAMPLE_SIZE;
+      data.update_sum_of_squares();
+      data.sequence = ring.latest_sequence() + 1;
+      ring.publish();
+    }
+  }
+
+private:
+  static constexpr uint32_t blockDuration_us = (microphone::PdmData::SAMPLE_SIZE * 1000000ULL) / SAMPLE_RATE;
+
+  // first channel of the file, at the file sample rate
+  std::vector<int16_t> samples;
+  uint32_t fileSampleRate = SAMPLE_RATE;
+  // position in the stream, in SAMPLE_RATE samples
+  uint64_t position = 0;
+  uint32_t nextBlockTime_us = 0;
+
+  void advance(const uint32_t count) { position += count; }
+
+  // nearest sample of the file, looped
+  int16_t sample_at(const uint64_t index) const
+  {
+    const uint64_t fileIndex = (index * fileSampleRate) / SAMPLE_RATE;
+    return samples[fileIndex % samples.size()];
+  }
+
+  template<typename T> static bool read_value(FILE* file, T& value) { return fread(&value, sizeof(T), 1, file) == 1; }
+
+  // parse the RIFF chunks, keep the first channel of the data chunk
+  bool read_wav(FILE* file)
+  {
+    char tag[4];
+    uint32_t size = 0;
+    if (fread(tag, 1, 4, file) != 4 or memcmp(tag, "RIFF", 4) != 0 or not read_value(file, size))
+      return false;
+    if (fread(tag, 1, 4, file) != 4 or memcmp(tag, "WAVE", 4) != 0)
+      return false;
+
+    uint16_t channels = 0;
+    uint16_t bitsPerSample = 0;
+    while (fread(tag, 1, 4, file) == 4 and read_value(file, size))
+    {
+      if (memcmp(tag, "fmt ", 4) == 0)
+      {
+        // the fields read below take 16 bytes, a shorter chunk is malformed
+        if (size < 16)
+          return false;
+
+        uint16_t format = 0;
+        uint32_t byteRate = 0;
+        uint16_t blockAlign = 0;
+        if (not(read_value(file, format) and read_value(file, channels) and read_value(file, fileSampleRate) and
+                read_value(file, byteRate) and read_value(file, blockAlign) and read_value(file, bitsPerSample)))
+          return false;
+        // PCM or WAVE_FORMAT_EXTENSIBLE
+        if ((format != 1 and format != 0xFFFE) or bitsPerSample != 16 or channels == 0 or fileSampleRate == 0)
+          return false;
+        fseek(file, size - 16 + (size % 2), SEEK_CUR);
+      }
+      else if (memcmp(tag, "data", 4) == 0)
+      {
+        if (channels == 0)
+          return false;
+
+        std::vector<int16_t> frame(channels);
+        const uint32_t frameCount = size / (channels * sizeof(int16_t));
+        samples.reserve(frameCount);
+        for (uint32_t i = 0; i < frameCount and fread(frame.data(), sizeof(int16_t), channels, file) == channels; i++)
+        {
+          samples.push_back(frame[0]);
+        }
+        return not samples.empty();
+      }
+      else
+      {
+        fseek(file, size + (size % 2), SEEK_CUR);
+      }
+    }
+    return false;
+  }
+};
+static WavSource wavSource;
+
+namespace mock_microphone {
+
+bool set_wav_source(const char* path) { return wavSource.open(path); }
+
+} // namespace mock_microphone
+
 namespace microphone {
 namespace _private {
 
-PdmData get() { return recorder.data; }
+const PdmData& get()
+{
+  if (wavSource.isOpen)
+  {
+    wavSource.update(recorder.ring);
+  }
+  return recorder.ring.latest();
+}
 
-bool start() { return recorder.start(16000); }
+const PdmData* get(const uint32_t sequence)
+{
+  if (wavSource.isOpen)
+  {
+    wavSource.update(recorder.ring);
+  }
+  return recorder.ring.get(sequence);
+}
 
-void stop() { recorder.stop(); }
+bool start()
+{
+  if (wavSource.isOpen)
+  {
+    wavSource.start();
+    return true;
+  }
+  return recorder.start(16000);
+}
+
+void stop()
+{
+  if (not wavSource.isOpen)
+  {
+    recorder.stop();
+  }
+}
+
+// same analysis as the lamp, with the portable fixed-point FFT backend
+static FftAnalyzer<PdmData::SAMPLE_SIZE, SoundStruct::numberOfFFtChanels, FixedFftBackend> fftAnalyzer;
+static SoundStruct soundStruct;
 
-// TODO issue #132
-SoundStruct soundStruct;
-SoundStruct process_fft(const PdmData& data) { return soundStruct; }
+const SoundStruct& process_fft(const PdmData& data)
+{
+  if (not data.is_valid())
+  {
+    soundStruct.isValid = false;
+    return soundStruct;
+  }
+
+  for (uint16_t i = 0; i < PdmData::SAMPLE_SIZE; i++)
+  {
+    fftAnalyzer.set_data(i < data.sampleRead ? data.data[i] : 0, i);
+  }
+  fftAnalyzer.FFTcode();
+
+  soundStruct.isValid = true;
+  soundStruct.fftMajorPeakFrequency_Hz = fftAnalyzer.get_major_peak();
+  soundStruct.strongestPeakMagnitude = fftAnalyzer.get_magnitude();
+  for (uint8_t bandIndex = 0; bandIndex < SoundStruct::numberOfFFtChanels; ++bandIndex)
+  {
+    soundStruct.fft[bandIndex] = fftAnalyzer.get_fft(bandIndex);
+  }
+  return soundStruct;
+}
 
 } // namespace _private
 } // namespace microphone
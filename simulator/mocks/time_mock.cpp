@@ -11,10 +11,39 @@ static sf::Clock s_clock;
 
 #include <stdint.h>
 
-uint32_t time_ms(void) { return s_clock.getElapsedTime().asMilliseconds() * sim::globals::state.slowTimeFactor; }
-
-uint32_t time_us(void) { return s_clock.getElapsedTime().asMicroseconds() * sim::globals::state.slowTimeFactor; }
-
-void delay_ms(uint32_t dwMs) { sf::sleep(sf::milliseconds(dwMs / sim::globals::state.slowTimeFactor)); }
-
-void delay_us(uint32_t dwUs) { sf::sleep(sf::microseconds(dwUs / sim::globals::state.slowTimeFactor)); }
+// virtual time: computations take no time, delays return immediately
+static auto& s_state = sim::globals::state;
+
+uint32_t time_ms(void)
+{
+  if (s_state.isVirtualTime)
+    return s_state.virtualTime_us / 1000;
+  return s_clock.getElapsedTime().asMilliseconds() * s_state.slowTimeFactor;
+}
+
+uint32_t time_us(void)
+{
+  if (s_state.isVirtualTime)
+    return s_state.virtualTime_us;
+  return s_clock.getElapsedTime().asMicroseconds() * s_state.slowTimeFactor;
+}
+
+void delay_ms(uint32_t dwMs)
+{
+  if (s_state.isVirtualTime)
+  {
+    s_state.virtualTime_us += dwMs * 1000ULL;
+    return;
+  }
+  sf::sleep(sf::milliseconds(dwMs / s_state.slowTimeFactor));
+}
+
+void delay_us(uint32_t dwUs)
+{
+  if (s_state.isVirtualTime)
+  {
+    s_state.virtualTime_us += dwUs;
+    return;
+  }
+  sf::sleep(sf::microseconds(dwUs / s_state.slowTimeFactor));
+}
@@ -0,0 +1,34 @@
+#include "benchmark.h"
+
+#include <cstdlib>
+#include <new>
+
+//
+// count the heap allocations of the benchmarked code
+//
+
+namespace benchmark {
+
+AllocationStats allocations;
+
+} // namespace benchmark
+
+void* operator new(std::size_t size)
+{
+  if (benchmark::allocations.isCounting)
+  {
+    benchmark::allocations.count += 1;
+    benchmark::allocations.bytes += size;
+  }
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+void* operator new[](std::size_t size) { return operator new(size); }
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
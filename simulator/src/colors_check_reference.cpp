@@ -0,0 +1,27 @@
+// float versions of the palette lookups, for the colors check
+#include "src/compile.h"
+#undef LMBD_FIXED_POINT_COLORS
+
+#include "colors_check.h"
+
+#include "src/system/utils/color_kernels.h"
+#include "src/system/utils/utils.h"
+
+namespace colors_check::reference {
+
+// the float get_color_from_palette, in this namespace (all its includes are already done)
+#include "src/system/colors/palettes.cpp"
+
+uint32_t from_palette(uint8_t index, const modes::colors::PaletteTy& palette, uint8_t brightness, bool loops)
+{
+  return loops ? modes::colors::from_palette<true>(index, palette, brightness)
+               : modes::colors::from_palette<false>(index, palette, brightness);
+}
+
+uint32_t from_palette(uint16_t index, const modes::colors::PaletteTy& palette, uint8_t brightness, bool loops)
+{
+  return loops ? modes::colors::from_palette<true, uint16_t>(index, palette, brightness)
+               : modes::colors::from_palette<false, uint16_t>(index, palette, brightness);
+}
+
+} // namespace colors_check::reference
@@ -0,0 +1,3 @@
+#include "colors_check.h"
+
+int main(int argc, char** argv) { return colors_check::run(argc, argv); }
@@ -0,0 +1,3 @@
+#include "headless.h"
+
+int main(int argc, char** argv) { return headless::run(argc, argv); }
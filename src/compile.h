@@ -13,6 +13,10 @@
 // #define DEBUG_MODE
 #define USE_BLUETOOTH
 
+// integer palette lookups, bit-exact with the float versions (see indexable-colors-check)
+// comment to use the float versions
+#define LMBD_FIXED_POINT_COLORS
+
 //
 // lamp type detection
 //
@@ -28,6 +28,7 @@ struct FireMode : public BasicMode
   struct StateTy
   {
     audio::SoundEventTy<> soundEvent;
+    colors::PaletteCacheTy<false, uint8_t> paletteCache;
   };
 
   static void reset(auto& ctx)
@@ -65,13 +66,16 @@ struct FireMode : public BasicMode
     }
 
     // for each line, generate noise & set pixels
+    auto& paletteCache = ctx.state.paletteCache;
+    paletteCache.update(palette);
+    uint8_t flames[ctx.lamp.maxWidth];
     for (uint16_t j = 0; j < ctx.lamp.maxHeight; ++j)
     {
+      noise8::fill_noise_3d(flames, ctx.lamp.maxWidth, 1, 0, xScale, j * yScale + ySpeed, yScale, zSpeed);
       for (uint16_t i = 0; i < ctx.lamp.maxWidth; ++i)
       {
-        const auto flame = noise8::inoise(i * xScale, j * yScale + ySpeed, zSpeed);
-        const auto pixel = MIN(223, qsub8(flame, decay[j]));
-        const auto color = modes::colors::from_palette<false, uint8_t>(pixel, palette);
+        const auto pixel = MIN(223, qsub8(flames[i], decay[j]));
+        const auto color = paletteCache.get(pixel);
 
         ctx.lamp.setPixelColorXY(i, j, color);
       }
@@ -9,6 +9,10 @@
 #include <cstdint>
 #include <array>
 
+#include "src/compile.h"
+#include "src/system/colors/palette_cache.h"
+#include "src/system/utils/color_kernels.h"
+
 #include "src/modes/include/colors/utils.hpp"
 
 namespace modes::colors {
@@ -469,10 +473,18 @@ static constexpr uint32_t from_palette(UIntTy index, const PaletteTy& palette, u
   // support for uint16_t
   if constexpr (sizeof(UIntTy) > 1)
   {
+#ifdef LMBD_FIXED_POINT_COLORS
+    // index * 16 / UINT16_MAX as 8.8 fixed point
+    // (the +7 reproduces the rounding of the float division, checked on all indexes)
+    const uint32_t percent = (index * 4096u + 7) / UINT16_MAX;
+    renormIndex = percent >> 8;
+    blendIndex = percent & 0xff;
+#else
     const float findex = index;
     const float percent = (findex / ((float)UINT16_MAX)) * 16.f;
     renormIndex = percent;
     blendIndex = 256.f * (percent - renormIndex);
+#endif
     static_assert(std::is_same_v<UIntTy, uint16_t>, "u8 or u16");
   }
 
@@ -480,6 +492,24 @@ static constexpr uint32_t from_palette(UIntTy index, const PaletteTy& palette, u
     return 0;
   const uint32_t entry = palette[renormIndex];
 
+#ifdef LMBD_FIXED_POINT_COLORS
+  uint32_t rgb = entry & 0xffffff;
+
+  // bit-exact with the float version below
+  if (blendIndex != 0)
+  {
+    const uint32_t nextColor = (renormIndex == 15) ? (PaletteLoops ? palette[0] : palette[15]) : palette[1 + renormIndex];
+    rgb = utils::kernels::interpolate(rgb, nextColor & 0xffffff, blendIndex << 4);
+  }
+
+  if (brightness != 255)
+  {
+    rgb = (brightness != 0) ? utils::kernels::scale_lit(rgb, brightness) : 0;
+  }
+
+  return rgb;
+#else
+
   // convert to rgb
   uint8_t red1 = (entry & 0xff0000) >> 16;
   uint8_t green1 = (entry & 0x00ff00) >> 8;
@@ -552,8 +582,27 @@ static constexpr uint32_t from_palette(UIntTy index, const PaletteTy& palette, u
   outputColor = (outputColor << 8) | green1;
   outputColor = (outputColor << 8) | blue1;
   return outputColor;
+#endif
 }
 
+/** \brief Table of all the colors of a palette, as returned by from_palette
+ *
+ * Typical usage is, with the cache stored in the mode state:
+ *
+ * @code{.cpp}
+ *   ctx.state.paletteCache.update(palette); // once per frame, no-op if unchanged
+ *   const uint32_t color = ctx.state.paletteCache.get(index);
+ * @endcode
+ */
+template<bool PaletteLoops = true, typename UIntTy = uint8_t> struct PaletteCacheTy : public utils::PaletteCache<UIntTy>
+{
+  /// Expand \p palette at \p brightness, only if they changed since the last call
+  bool update(const PaletteTy& palette, uint8_t brightness = 255)
+  {
+    return utils::PaletteCache<UIntTy>::update(palette, brightness, from_palette<PaletteLoops, UIntTy>);
+  }
+};
+
 } // namespace modes::colors
 
 #endif
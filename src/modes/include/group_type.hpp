@@ -42,7 +42,7 @@ template<typename AllModes, bool earlyFail = verifyGroup<AllModes>()> struct Gro
   // tuple helper
   using SelfTy = GroupTy<AllModes>;
   using AllModesTy = AllModes;
-  using AllStatesTy = details::StateTyFrom<AllModes>;
+  using AllStatesTy = details::ModeStateTyFrom<AllModes>;
   static constexpr uint8_t nbModes {std::tuple_size_v<AllModesTy>};
 
   // last mode index must not collide with modes::store::noModeIndex
@@ -139,6 +139,37 @@ template<typename AllModes, bool earlyFail = verifyGroup<AllModes>()> struct Gro
     }
   };
 
+  /// \private Size of each mode state (0 if empty or persistent)
+  static constexpr std::array<size_t, nbModes> modeStateSizes = []() {
+    std::array<size_t, nbModes> sizes = {};
+    details::unroll<nbModes>([&](auto Idx) {
+      using ModeHere = ModeAtRaw<decltype(Idx)::value>;
+      using StateHere = StateTyOf<ModeHere>;
+      if constexpr (!std::is_same_v<StateHere, NoState> && !details::hasPersistentState<ModeHere>)
+      {
+        sizes[decltype(Idx)::value] = sizeof(StateHere);
+      }
+    });
+    return sizes;
+  }();
+
+  /// \private Size & alignment required to store any mode state in the arena
+  static constexpr size_t modeStateArenaSize = []() {
+    size_t acc = 1;
+    for (size_t size: modeStateSizes)
+      acc = size > acc ? size : acc;
+    return acc;
+  }();
+
+  static constexpr size_t modeStateArenaAlign = []() {
+    size_t acc = 1;
+    details::unroll<nbModes>([&](auto Idx) {
+      using StateHere = StateTyOf<ModeAtRaw<decltype(Idx)::value>>;
+      acc = alignof(StateHere) > acc ? alignof(StateHere) : acc;
+    });
+    return acc;
+  }();
+
   template<typename Mode> static auto* LMBD_INLINE getStateOf(auto& manager)
   {
     using StateTy = typename Mode::StateTy;
@@ -149,12 +180,17 @@ template<typename AllModes, bool earlyFail = verifyGroup<AllModes>()> struct Gro
       using ModeHere = ModeAt<Idx>;
       constexpr bool isHere = std::is_same_v<ModeHere, Mode>;
 
-      if constexpr (isHere)
+      if constexpr (isHere && !details::hasPersistentState<Mode>)
+      {
+        // only the active mode state is alive, in the shared arena
+        substate = &manager.template getArenaStateOf<Mode, StateTy>();
+      }
+      else if constexpr (isHere)
       {
         auto* state = manager.template getStateGroupOf<SelfTy>();
         if (state)
         {
-          OptionalTy& opt = std::get<OptionalTy>(state->modeStates);
+          OptionalTy& opt = std::get<Idx>(state->modeStates);
           if (!opt.has_value())
           {
             opt.emplace(); // all StateTy must be default-contructible :)
@@ -277,8 +313,19 @@ template<typename AllModes, bool earlyFail = verifyGroup<AllModes>()> struct Gro
 
   static void user_thread(auto& ctx)
   {
-    dispatch_mode(ctx, [](auto mode) {
-      mode.user_thread();
+    // only bind the modes requiring the user thread: the state of the other
+    // modes lives in the mode state arena, that the main thread rebuilds on
+    // mode switches
+    uint8_t modeId = ctx.get_active_mode(nbModes);
+
+    details::unroll<nbModes>([&](auto Idx) LMBD_INLINE {
+      if constexpr (ModeAt<Idx>::requireUserThread)
+      {
+        if (Idx == modeId)
+        {
+          context_as<ModeAt<Idx>>(ctx).user_thread();
+        }
+      }
     });
   }
 };
@@ -11,6 +11,7 @@
 #include "src/system/ext/math8.h"
 
 #ifdef LMBD_LAMP_TYPE__INDEXABLE
+#include "src/system/utils/color_kernels.h"
 #include "src/system/utils/strip.h"
 #include "src/system/physical/output_power.h"
 #endif
@@ -437,10 +438,7 @@ public:
   {
     if constexpr (flavor == LampTypes::indexable)
     {
-      for (uint16_t I = 0; I < ledCount; ++I)
-      {
-        strip.setPixelColor(I, color);
-      }
+      strip._framebuffer.fill(color);
     }
     else
     {
@@ -460,10 +458,8 @@ public:
       assert(start < ledCount && "invalid start parameter");
       assert(end < ledCount && "invalid end parameter");
 
-      for (uint16_t I = start; I < end; ++I)
-      {
-        strip.setPixelColor(I, color);
-      }
+      if (start < end)
+        strip._framebuffer.fill(color, start, end - start);
     }
     else
     {
@@ -522,27 +518,31 @@ public:
 
   /** \brief (indexable) Display \p bufIdx temporary buffer as LED colors
    *
-   * This ``memcpy`` the selected buffer to the internal strip color buffer.
+   * This ``memcpy`` the selected buffer to the internal strip framebuffer.
    */
   template<uint8_t bufIdx = 0> void setColorsFromBuffer()
   {
-    static_assert(sizeof(BufferTy) == sizeof(strip._colors));
+    static_assert(sizeof(BufferTy) == sizeof(uint32_t) * ledCount);
     const BufferTy& buffer = getTempBuffer<bufIdx>();
+
+    uint16_t Idx = 0;
     if (config.skipFirstLedsForEffect)
     {
-      uint16_t Idx = config.skipFirstLedsForAmount;
-      uint16_t Sz = sizeof(strip._colors) - Idx * sizeof(uint32_t);
-      memcpy(&strip._colors[Idx], &buffer[Idx], Sz);
-    }
-    else
-    {
-      memcpy(strip._colors, buffer.data(), sizeof(strip._colors));
+      Idx = config.skipFirstLedsForAmount;
     }
+
+    if (Idx < ledCount)
+      strip._framebuffer.blit(&buffer[Idx], Idx, ledCount - Idx);
   }
 
+  /** \brief (indexable) Display a mix of two temporary buffers
+   *
+   * Display \p srcBufIdx when \p phase is 0, \p dstBufIdx when \p phase is 1
+   * and a blend of both in between. The white channel is not displayed.
+   */
   template<uint8_t dstBufIdx = 0, uint8_t srcBufIdx = 1> void setColorsFromMixedBuffers(float phase)
   {
-    static_assert(sizeof(BufferTy) == sizeof(strip._colors));
+    static_assert(sizeof(BufferTy) == sizeof(uint32_t) * ledCount);
     const BufferTy& dstBuf = getTempBuffer<dstBufIdx>();
     const BufferTy& srcBuf = getTempBuffer<srcBufIdx>();
 
@@ -552,20 +552,18 @@ public:
       start = config.skipFirstLedsForAmount;
     }
 
-    for (uint16_t I = start; I < end; ++I)
-    {
-      COLOR src, dst;
-      src.color = srcBuf[I];
-      dst.color = dstBuf[I];
-      strip._colors[I].color = utils::get_gradient(src.color, dst.color, phase);
-    }
+    const uint8_t amount = lmpd_constrain(phase, 0.0f, 1.0f) * 255.0f;
+    strip._framebuffer.write_span(start, end - start, [&](uint32_t* out, uint16_t count) {
+      // as the previous per-pixel gradient, drop the white channel
+      utils::kernels::blend_span(out, &srcBuf[start], &dstBuf[start], count, amount, 0x00ffffff);
+    });
   }
 
   /** \brief (indexable) Display \p bufIdx temporary buffer, but reversed
    */
   template<uint8_t bufIdx = 0> void setColorsFromBufferReversed(bool skipLastLine)
   {
-    static_assert(sizeof(BufferTy) == sizeof(strip._colors));
+    static_assert(sizeof(BufferTy) == sizeof(uint32_t) * ledCount);
     const BufferTy& buffer = getTempBuffer<bufIdx>();
 
     uint16_t start = 0, end = buffer.size();
@@ -579,10 +577,8 @@ public:
       end = maxWidth * maxHeight;
     }
 
-    for (uint16_t I = 0, J = start; I < end - start; ++I, ++J)
-    {
-      strip._colors[J].color = buffer[end - start - I - 1];
-    }
+    if (start < end)
+      strip._framebuffer.blit_reversed(buffer.data(), start, end - start);
   }
 
   /** \brief (indexable) Copy all current LEDs color to \p bufIdx temp. buffer
@@ -591,20 +587,20 @@ public:
    */
   template<uint8_t bufIdx = 0, bool forceFullRead = false> void getColorsToBuffer()
   {
-    static_assert(sizeof(BufferTy) == sizeof(strip._colors));
+    static_assert(sizeof(BufferTy) == sizeof(uint32_t) * ledCount);
 
     BufferTy& buffer = getTempBuffer<bufIdx>();
     if (!forceFullRead && config.skipFirstLedsForEffect)
     {
       uint16_t Idx = config.skipFirstLedsForAmount;
-      uint16_t Sz = sizeof(strip._colors) - Idx * sizeof(uint32_t);
 
       buffer.fill(0);
-      memcpy(&buffer[Idx], &strip._colors[Idx], Sz);
+      if (Idx < ledCount)
+        strip._framebuffer.copy_to(&buffer[Idx], Idx, ledCount - Idx);
     }
     else
     {
-      memcpy(buffer.data(), strip._colors, sizeof(strip._colors));
+      strip._framebuffer.copy_to(buffer.data(), 0, ledCount);
     }
   }
 
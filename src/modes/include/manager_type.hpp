@@ -287,6 +287,56 @@ template<typename Config, typename AllGroups> struct ModeManagerTy
     return substate;
   }
 
+  //
+  // mode state arena
+  //
+
+  /// \private Largest mode state of all groups (states of modes not alive share it)
+  static constexpr size_t modeStateArenaSize = []() {
+    size_t acc = 1;
+    details::unroll<nbGroups>([&](auto Idx) {
+      constexpr size_t sizeHere = GroupAt<decltype(Idx)::value>::modeStateArenaSize;
+      acc = sizeHere > acc ? sizeHere : acc;
+    });
+    return acc;
+  }();
+
+  /// \private Strictest alignment of all mode states
+  static constexpr size_t modeStateArenaAlign = []() {
+    size_t acc = 1;
+    details::unroll<nbGroups>([&](auto Idx) {
+      constexpr size_t alignHere = GroupAt<decltype(Idx)::value>::modeStateArenaAlign;
+      acc = alignHere > acc ? alignHere : acc;
+    });
+    return acc;
+  }();
+
+  using StateArenaTy = details::StateArena<modeStateArenaSize, modeStateArenaAlign>;
+
+  /** \brief Size in bytes of the state of a mode stored in the arena
+   *
+   * Returns 0 for modes without state, or whose state is persistent (modes
+   * with system callbacks) and allocated for the whole program lifetime.
+   */
+  static size_t get_mode_state_size(const uint8_t groupId, const uint8_t modeId)
+  {
+    size_t size = 0;
+    details::unroll<nbGroups>([&](auto Idx) {
+      using GroupHere = GroupAt<Idx>;
+      if (Idx == groupId && modeId < GroupHere::nbModes)
+      {
+        size = GroupHere::modeStateSizes[modeId];
+      }
+    });
+    return size;
+  }
+
+  /// \private Get the state of \p Mode from the arena, destroying the previous one
+  template<typename Mode, typename ModeStateTy> ModeStateTy& LMBD_INLINE getArenaStateOf()
+  {
+    return modeStateArena.template get<Mode, ModeStateTy>();
+  }
+
   template<typename Mode> StateTyOf<Mode>& LMBD_INLINE getStateOf()
   {
     using TargetStateTy = StateTyOf<Mode>;
@@ -618,6 +668,7 @@ template<typename Config, typename AllGroups> struct ModeManagerTy
 private:
   NoState placeholder;
   StateTy state;
+  StateArenaTy modeStateArena;
 };
 
 /** \brief Same as modes::ManagerFor but with custom defaults
@@ -51,7 +51,13 @@ namespace modes {
  */
 struct BasicMode
 {
-  /// Mode custom static state, made available through context (optional)
+  /** \brief Mode custom static state, made available through context (optional)
+   *
+   * States of all modes share the same storage: the state is constructed
+   * when the mode becomes active, and destroyed when switching to another
+   * mode, unless the mode has system callbacks or requires the user thread
+   * (then it lives forever).
+   */
   struct StateTy
   {
   };
@@ -5,6 +5,8 @@
 #include <utility>
 #include <optional>
 #include <tuple>
+#include <new>
+#include <type_traits>
 
 #include "src/modes/include/compile.hpp"
 #include "src/modes/include/mode_type.hpp"
@@ -198,6 +200,86 @@ template<typename... Modes> static constexpr auto stateTyFromImpl(std::tuple<Mod
 /// \private Get std::tuple<Mode::StateTy...> from std::tuple<Mode...>
 template<typename AsTuple> using StateTyFrom = decltype(stateTyFromImpl((AsTuple*)0));
 
+//
+// StateArena & ModeStateTyFrom
+//
+
+/** \private Mode state must outlive mode switches
+ *
+ * Modes with system callbacks are called while not being active, and modes
+ * requiring the user thread may still be in user_thread() when the main
+ * thread switches modes, so their state can not live in the shared mode
+ * state arena (that destroys the previous state on switch).
+ */
+template<typename Mode>
+static constexpr bool hasPersistentState = Mode::hasSystemCallbacks or Mode::requireUserThread;
+
+/// \private Storage of a mode state in its group (NoState if in arena)
+template<typename Mode>
+using ModeStorageTyOf = std::conditional_t<hasPersistentState<Mode>, std::optional<StateTyOf<Mode>>, NoState>;
+
+template<typename... Modes> static constexpr auto modeStateTyFromImpl(std::tuple<Modes...>*)
+        -> std::tuple<ModeStorageTyOf<Modes>...>;
+
+/// \private Get std::tuple<Mode storage...> from std::tuple<Mode...>
+template<typename AsTuple> using ModeStateTyFrom = decltype(modeStateTyFromImpl((AsTuple*)0));
+
+/// \private Unique address used to tag the mode owning the arena
+template<typename Mode> inline constexpr char arenaTag = 0;
+
+/** \private Storage shared by the states of all non-persistent modes
+ *
+ * Only the state of the last mode that asked for it is alive: asking for the
+ * state of another mode destroys the previous one, then default-constructs
+ * the new state in place.
+ *
+ * Only accessed from the main thread: GroupTy::user_thread() never binds a
+ * mode with its state in the arena.
+ */
+template<size_t Size, size_t Align> struct StateArena
+{
+  static constexpr size_t size = Size;
+
+  StateArena() = default;
+  StateArena(const StateArena&) = delete;
+  StateArena& operator=(const StateArena&) = delete;
+  ~StateArena() { clear(); }
+
+  /// Return the state of \p Mode, constructed if not already alive
+  template<typename Mode, typename StateTy> StateTy& LMBD_INLINE get()
+  {
+    static_assert(sizeof(StateTy) <= Size, "Mode state does not fit in the arena!");
+    static_assert(alignof(StateTy) <= Align, "Mode state is over-aligned for the arena!");
+
+    if (_tag != &arenaTag<Mode>)
+    {
+      clear();
+      new (_storage) StateTy(); // all StateTy must be default-contructible :)
+      _destroy = [](void* ptr) {
+        static_cast<StateTy*>(ptr)->~StateTy();
+      };
+      _tag = &arenaTag<Mode>;
+    }
+    return *std::launder(reinterpret_cast<StateTy*>(_storage));
+  }
+
+  /// Destroy the state currently alive, if any
+  void clear()
+  {
+    if (_destroy != nullptr)
+    {
+      _destroy(_storage);
+    }
+    _destroy = nullptr;
+    _tag = nullptr;
+  }
+
+private:
+  alignas(Align) uint8_t _storage[Size];
+  void (*_destroy)(void*) = nullptr;
+  const void* _tag = nullptr;
+};
+
 //
 // ModeBelongsTo & GroupBelongsTo
 //
@@ -319,11 +319,19 @@ struct LiquideMode : public LegacyMode
 
   struct StateTy
   {
+    StateTy() = default;
+    // _colors points into this state
+    StateTy(const StateTy&) = delete;
+    StateTy& operator=(const StateTy&) = delete;
+
+    // colors are owned by the state, that is rebuilt when the mode is entered
+    GeneratePalette _oceanColor = GeneratePalette(2, PaletteOceanColors);
+    GenerateRainbowSwirl _swirlColor = GenerateRainbowSwirl(5000);
+    GeneratePalette _auroraColor = GeneratePalette(2, PaletteAuroraColors);
+    GeneratePalette _forestColor = GeneratePalette(2, PaletteForestColors);
+
     // store references to palettes
-    DynamicColor* _colors[4] = {new GeneratePalette(2, PaletteOceanColors),
-                                new GenerateRainbowSwirl(5000),
-                                new GeneratePalette(2, PaletteAuroraColors),
-                                new GeneratePalette(2, PaletteForestColors)};
+    DynamicColor* _colors[4] = {&_oceanColor, &_swirlColor, &_auroraColor, &_forestColor};
     const uint8_t maxPalettesCount = 4;
 
     DynamicColor* _color;
@@ -226,4 +226,40 @@ void user_thread()
   }
 }
 
+#ifdef LMBD_SIMULATION
+namespace _private {
+
+uint8_t get_groups_count()
+{
+  auto manager = get_context();
+  return manager.get_groups_count();
+}
+
+uint8_t get_modes_count(const uint8_t groupIndex)
+{
+  auto manager = get_context();
+  const uint8_t activeGroup = manager.get_active_group();
+  manager.set_active_group(groupIndex, manager.get_groups_count());
+  const uint8_t modeCount = manager.get_modes_count();
+  manager.set_active_group(activeGroup);
+  return modeCount;
+}
+
+void select_mode(const uint8_t groupIndex, const uint8_t modeIndex)
+{
+  auto manager = get_context();
+  manager.set_active_group(groupIndex, manager.get_groups_count());
+  manager.set_active_mode(modeIndex, manager.get_modes_count());
+  manager.reset_mode();
+}
+
+size_t get_mode_state_size(const uint8_t groupIndex, const uint8_t modeIndex)
+{
+  using ManagerTy = decltype(get_context())::ModeManagerTy;
+  return ManagerTy::get_mode_state_size(groupIndex, modeIndex);
+}
+
+} // namespace _private
+#endif
+
 #endif
@@ -25,6 +25,7 @@
 #include "src/system/utils/state_machine.h"
 #include "src/system/utils/input_output.h"
 #include "src/system/utils/print.h"
+#include "src/system/utils/profiler.h"
 #include "src/system/utils/brightness_handle.h"
 
 #include "src/system/platform/bluetooth.h"
@@ -652,6 +653,7 @@ void handle_output_light_state()
   else
   {
     // user loop call
+    const profiler::ScopedTimer timer(profiler::Stage::userLoop);
     user::loop();
 
 // TODO issue #136
@@ -778,7 +780,10 @@ void loop()
 
   // do not display alerts for the first 500 ms
   const bool shouldIgnoreAlerts = (time_ms() - turnOnTime) < 500;
-  alerts::handle_all(shouldIgnoreAlerts);
+  {
+    const profiler::ScopedTimer timer(profiler::Stage::alerts);
+    alerts::handle_all(shouldIgnoreAlerts);
+  }
   // alert requested an emergency shutdown, do it
   if (alerts::is_request_shutdown())
   {
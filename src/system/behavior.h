@@ -17,6 +17,8 @@
 
 #include "src/system/platform/gpio.h"
 
+#include <string>
+
 namespace behavior {
 
 /**
@@ -23,27 +23,27 @@
 
 namespace animations {
 
+// shared by the animations sampling a palette on every pixel at full brightness
+static utils::PaletteCache<uint8_t> paletteCache;
+
 void fill(const Color& color, LedStrip& strip, const float cutOff)
 {
   const float adaptedCutoff = min(max(cutOff, 0.0), 1.0);
   const uint16_t maxCutOff = min(max(adaptedCutoff * LED_COUNT, 1.0), LED_COUNT);
-  for (uint16_t i = 0; i < LED_COUNT; ++i)
-  {
-    const uint32_t c = color.get_color(i, LED_COUNT);
-    if (i >= maxCutOff)
-    {
-      // set a color gradient
-      float intPart, fracPart;
-      fracPart = modf(adaptedCutoff * LED_COUNT, &intPart);
-      // adapt the color to have a nice gradient
-      COLOR newC;
-      newC.color = c;
-      const uint16_t hue = utils::ColorSpace::HSV(newC).get_scaled_hue();
-      strip.setPixelColor(i, LedStrip::ColorHSV(hue, 255, fracPart * 255));
-      break;
-    }
+  strip.write_span(0, maxCutOff, [&](uint32_t* out, uint16_t count) {
+    color.fill(out, count, 0, LED_COUNT);
+  });
 
-    strip.setPixelColor(i, c);
+  if (maxCutOff < LED_COUNT)
+  {
+    // set a color gradient
+    float intPart, fracPart;
+    fracPart = modf(adaptedCutoff * LED_COUNT, &intPart);
+    // adapt the color to have a nice gradient
+    COLOR newC;
+    newC.color = color.get_color(maxCutOff, LED_COUNT);
+    const uint16_t hue = utils::ColorSpace::HSV(newC).get_scaled_hue();
+    strip.setPixelColor(maxCutOff, LedStrip::ColorHSV(hue, 255, fracPart * 255));
   }
 }
 
@@ -318,10 +318,7 @@ bool fade_in(const Color& color,
     strip.buffer_current_colors(0);
 
     // save initial state
-    for (uint16_t i = 0; i < LED_COUNT; ++i)
-    {
-      targetStates[i] = color.get_color(i, LED_COUNT);
-    }
+    color.fill(targetStates, LED_COUNT, 0, LED_COUNT);
 
     return false;
   }
@@ -352,6 +349,7 @@ void fire(const uint8_t scalex, const uint8_t scaley, const uint8_t speed, const
   static uint32_t step = 0;
   uint16_t zSpeed = step / (256 - speed);
   uint16_t ySpeed = time_ms() / (256 - speed);
+  update_palette_cache(paletteCache, palette);
   for (int i = 0; i < ceil(stripXCoordinates); i++)
   {
     for (int j = 0; j < ceil(stripYCoordinates); j++)
@@ -359,9 +357,8 @@ void fire(const uint8_t scalex, const uint8_t scaley, const uint8_t speed, const
       strip.setPixelColorXY(
               stripXCoordinates - i,
               j,
-              get_color_from_palette(qsub8(noise8::inoise(i * scalex, j * scaley + ySpeed, zSpeed),
-                                           abs8(j - (stripXCoordinates - 1)) * 255 / (stripXCoordinates - 1)),
-                                     palette));
+              paletteCache.get(qsub8(noise8::inoise(i * scalex, j * scaley + ySpeed, zSpeed),
+                                     abs8(j - (stripXCoordinates - 1)) * 255 / (stripXCoordinates - 1))));
     }
   }
   step++;
@@ -582,6 +579,7 @@ void mode_2DPolarLights(
   */
   uint16_t _scale = lmpd_map<uint8_t, uint16_t>(scale, 0, 255, 30, adjScale);
   byte _speed = lmpd_map<byte, byte>(speed, 0, 255, 128, 16);
+  update_palette_cache(paletteCache, palette);
 
   for (int x = 0; x <= cols; x++)
   {
@@ -591,9 +589,8 @@ void mode_2DPolarLights(
       strip.setPixelColorXY(
               x,
               y,
-              get_color_from_palette(qsub8(noise8::inoise((step % 2) + x * _scale, y * 16 + step % 16, step / _speed),
-                                           fabsf((float)rows / 2.0f - (float)y) * adjustHeight),
-                                     palette));
+              paletteCache.get(qsub8(noise8::inoise((step % 2) + x * _scale, y * 16 + step % 16, step / _speed),
+                                     fabsf((float)rows / 2.0f - (float)y) * adjustHeight)));
     }
   }
 }
@@ -738,6 +735,7 @@ void mode_sinewave(const uint8_t speed, const uint8_t intensity, const palette_t
 
   step += speed / 16;            // Speed of animation.
   uint16_t freq = intensity / 4; // SEGMENT.fft2/8;                       // Frequency of the signal.
+  update_palette_cache(paletteCache, palette);
 
   for (int i = 0; i < LED_COUNT; i++)
   {                                                 // For each of the LED's in the strand, set a brightness based on
@@ -748,7 +746,7 @@ void mode_sinewave(const uint8_t speed, const uint8_t intensity, const palette_t
                                                     // Otherwise, bright = 128 (as defined in qsub)..
     // setPixCol(i, i*colorIndex/255, pixBri);
     COLOR pixColor;
-    pixColor.color = get_color_from_palette((uint8_t)(i * colorIndex / 255), palette);
+    pixColor.color = paletteCache.get((uint8_t)(i * colorIndex / 255));
     COLOR back;
     back.color = 0;
     strip.setPixelColor(i, utils::color_blend(back, pixColor, pixBri));
@@ -774,6 +772,7 @@ void running_base(
 
   COLOR c2;
 
+  update_palette_cache(paletteCache, palette);
   for (int i = 0; i < LED_COUNT; i++)
   {
     uint16_t a = i * x_scale - counter;
@@ -792,14 +791,14 @@ void running_base(
     }
     uint8_t s = dual ? sin_gap(a) : sin8(a);
 
-    c2.color = get_color_from_palette((uint8_t)i, palette);
+    c2.color = paletteCache.get((uint8_t)i);
     COLOR ca = utils::color_blend(c1, c2, s);
     if (dual)
     {
       uint16_t b = (LED_COUNT - 1 - i) * x_scale - counter;
       uint8_t t = sin_gap(b);
 
-      c2.color = get_color_from_palette((uint8_t)i, palette);
+      c2.color = paletteCache.get((uint8_t)i);
 
       COLOR cb;
       cb = utils::color_blend(c1, c2, t);
@@ -11,6 +11,39 @@
 #include "src/system/utils/strip.h"
 #include "src/system/utils/utils.h"
 
+/**
+ * \brief Step floor(index * range / divisor) through consecutive indexes, without divisions
+ */
+struct RatioStepper
+{
+  RatioStepper(const uint16_t index, const uint32_t range, const uint16_t divisor) :
+    value((index * range) / divisor),
+    remainder((index * range) % divisor),
+    quotient(range / divisor),
+    step(range % divisor),
+    divisor(divisor)
+  {
+  }
+
+  // go to the next index
+  void next()
+  {
+    value += quotient;
+    remainder += step;
+    if (remainder >= divisor)
+    {
+      remainder -= divisor;
+      value += 1;
+    }
+  }
+
+  uint32_t value;
+  uint32_t remainder;
+  uint32_t quotient;
+  uint32_t step;
+  uint32_t divisor;
+};
+
 uint32_t GenerateSolidColor::get_color_internal(const uint16_t index, const uint16_t maxIndex) const { return _color; }
 
 uint32_t GenerateRainbowColor::get_color_internal(const uint16_t index, const uint16_t maxIndex) const
@@ -19,11 +52,68 @@ uint32_t GenerateRainbowColor::get_color_internal(const uint16_t index, const ui
   return utils::hue_to_rgb_sinus(hue);
 }
 
+void GenerateRainbowColor::fill_internal(uint32_t* colors,
+                                         const uint16_t count,
+                                         const uint16_t startIndex,
+                                         const uint16_t maxIndex) const
+{
+  if (maxIndex == 0)
+    return Color::fill_internal(colors, count, startIndex, maxIndex);
+
+  // neighbor pixels often share their hue
+  RatioStepper hue(startIndex, 360, maxIndex);
+  uint32_t lastHue = UINT32_MAX;
+  uint32_t lastColor = 0;
+  for (uint16_t i = 0; i < count; ++i, hue.next())
+  {
+    // on exact multiples, the float mapping of get_color can round one degree lower
+    const uint32_t pixelHue = (hue.remainder == 0)
+                                      ? lmpd_map<uint16_t, uint16_t>(startIndex + i, 0, maxIndex, 0, 360)
+                                      : hue.value;
+    if (pixelHue != lastHue)
+    {
+      lastHue = pixelHue;
+      lastColor = utils::hue_to_rgb_sinus(lastHue);
+    }
+    colors[i] = lastColor;
+  }
+}
+
 uint32_t GenerateGradientColor::get_color_internal(const uint16_t index, const uint16_t maxIndex) const
 {
   return utils::get_gradient(_colorStart, _colorEnd, index / (float)maxIndex);
 }
 
+void GenerateGradientColor::fill_internal(uint32_t* colors,
+                                          const uint16_t count,
+                                          const uint16_t startIndex,
+                                          const uint16_t maxIndex) const
+{
+  if (maxIndex == 0)
+    return Color::fill_internal(colors, count, startIndex, maxIndex);
+
+  COLOR start, end;
+  start.color = _colorStart;
+  end.color = _colorEnd;
+
+  // channels in 16.16 fixed point, incremented once per index
+  const int32_t redStep = ((end.red - start.red) * 65536) / maxIndex;
+  const int32_t greenStep = ((end.green - start.green) * 65536) / maxIndex;
+  const int32_t blueStep = ((end.blue - start.blue) * 65536) / maxIndex;
+  int32_t red = start.red * 65536 + startIndex * redStep;
+  int32_t green = start.green * 65536 + startIndex * greenStep;
+  int32_t blue = start.blue * 65536 + startIndex * blueStep;
+
+  for (uint16_t i = 0; i < count; ++i)
+  {
+    colors[i] = (static_cast<uint32_t>(red >> 16) << 16) | (static_cast<uint32_t>(green >> 16) << 8) |
+                static_cast<uint32_t>(blue >> 16);
+    red += redStep;
+    green += greenStep;
+    blue += blueStep;
+  }
+}
+
 uint32_t GenerateRoundColor::get_color_internal(const uint16_t index, const uint16_t maxIndex) const
 {
   const double segmentsPerTurns = 3.1;
@@ -37,40 +127,85 @@ uint32_t GenerateRainbowSwirl::get_color_internal(const uint16_t index, const ui
   return utils::hue_to_rgb_sinus(lmpd_map<uint16_t, uint16_t>(pixelHue, 0, UINT16_MAX, 0, 360));
 }
 
-uint32_t GeneratePalette::get_color_internal(const uint16_t index, const uint16_t maxIndex) const
+void GenerateRainbowSwirl::fill_internal(uint32_t* colors,
+                                         const uint16_t count,
+                                         const uint16_t startIndex,
+                                         const uint16_t maxIndex) const
 {
-  const uint16_t indexAdded = (index + _index) % UINT16_MAX;
-  return get_color_from_palette(static_cast<uint8_t>(indexAdded / static_cast<float>(maxIndex) * UINT8_MAX),
-                                *_paletteRef);
+  if (maxIndex == 0)
+    return Color::fill_internal(colors, count, startIndex, maxIndex);
+
+  RatioStepper offset(startIndex, UINT16_MAX, maxIndex);
+  for (uint16_t i = 0; i < count; ++i, offset.next())
+  {
+    const uint16_t pixelHue = _firstPixelHue + offset.value;
+    // same as the float mapping of get_color, for all the 16 bits hues
+    colors[i] = utils::hue_to_rgb_sinus((pixelHue * 360) / UINT16_MAX);
+  }
 }
 
-uint32_t GeneratePaletteStep::get_color_internal(const uint16_t index, const uint16_t maxIndex) const
-{
-  return get_color_from_palette(_index, *_paletteRef);
-}
+// shared by the palette colors: their palettes are constant, so checking the identity is enough
+static utils::PaletteCache<uint8_t> paletteCache;
 
-uint32_t GeneratePaletteIndexed::get_color_internal(const uint16_t index, const uint16_t maxIndex) const
+static const utils::PaletteCache<uint8_t>& get_palette_cache(const palette_t& palette)
 {
-  return get_color_from_palette(_index, *_paletteRef);
+  if (not paletteCache.holds(palette, 255))
+    update_palette_cache(paletteCache, palette);
+  return paletteCache;
 }
 
-uint32_t GenerateRainbowPulse::get_color_internal(const uint16_t index, const uint16_t maxIndex) const
+uint32_t GeneratePalette::get_color_internal(const uint16_t index, const uint16_t maxIndex) const
 {
-  return LedStrip::ColorHSV(_currentPixelHue);
+  if (maxIndex == 0)
+    return get_palette_cache(*_paletteRef).get(0);
+
+  // same integer ratio as fill_internal (the palette index wraps around)
+  const uint16_t indexAdded = (index + _index) % UINT16_MAX;
+  return get_palette_cache(*_paletteRef).get(static_cast<uint8_t>((indexAdded * UINT8_MAX) / maxIndex));
 }
 
-uint32_t GenerateRainbowIndex::get_color_internal(const uint16_t index, const uint16_t maxIndex) const
+void GeneratePalette::fill_internal(uint32_t* colors,
+                                    const uint16_t count,
+                                    const uint16_t startIndex,
+                                    const uint16_t maxIndex) const
 {
-  return LedStrip::ColorHSV(_currentPixelHue);
+  if (maxIndex == 0)
+    return Color::fill_internal(colors, count, startIndex, maxIndex);
+
+  const utils::PaletteCache<uint8_t>& cache = get_palette_cache(*_paletteRef);
+  uint16_t indexAdded = (startIndex + _index) % UINT16_MAX;
+  RatioStepper paletteIndex(indexAdded, UINT8_MAX, maxIndex);
+  for (uint16_t i = 0; i < count; ++i)
+  {
+    // the palette index wraps around
+    colors[i] = cache.get(static_cast<uint8_t>(paletteIndex.value));
+
+    indexAdded += 1;
+    if (indexAdded == UINT16_MAX)
+    {
+      indexAdded = 0;
+      paletteIndex = RatioStepper(0, UINT8_MAX, maxIndex);
+    }
+    else
+      paletteIndex.next();
+  }
 }
 
-uint32_t GeneratePastelPulse::get_color_internal(const uint16_t index, const uint16_t maxIndex) const
+void GeneratePaletteStep::update_color() { _color = get_palette_cache(*_paletteRef).get(_index); }
+
+void GeneratePaletteIndexed::update_color() { _color = get_palette_cache(*_paletteRef).get(_index); }
+
+void GenerateRainbowPulse::update_color() { _color = LedStrip::ColorHSV(_currentPixelHue); }
+
+void GenerateRainbowIndex::update_color() { _color = LedStrip::ColorHSV(_currentPixelHue); }
+
+void GeneratePastelPulse::update_color()
 {
-  const double hue = double(_currentPixelHue) / double(UINT16_MAX) * 360.0;
+  const float hue = float(_currentPixelHue) / float(UINT16_MAX) * 360.0f;
 
   // using OKLCH will create softer colors
-  auto res = utils::ColorSpace::OKLCH(0.752, 0.126, hue);
-  return res.get_rgb().color;
+  auto res = utils::ColorSpace::OKLCH(0.752f, 0.126f, hue);
+  _color = res.get_rgb().color;
 }
 
 GenerateRandomColor::GenerateRandomColor() : _color(utils::get_random_color()) {}
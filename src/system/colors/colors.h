@@ -27,6 +27,38 @@ public:
     return get_color_internal(lmpd_constrain(index, 0, maxIndex), maxIndex);
   }
 
+  /**
+   * \brief Write the colors of \p count consecutive indexes, from \p startIndex
+   * Same result as a get_color call per index, with the per call setup done once
+   */
+  void fill(uint32_t* colors, const uint16_t count, const uint16_t startIndex, const uint16_t maxIndex) const
+  {
+    if (is_index_invariant())
+    {
+      // compute once, then splat
+      const uint32_t color = get_color_internal(0, maxIndex);
+      for (uint16_t i = 0; i < count; ++i)
+        colors[i] = color;
+      return;
+    }
+
+    // indexes over maxIndex get the color of maxIndex, as in get_color
+    const uint16_t inRangeCount = (startIndex > maxIndex) ? 0 : min(count, maxIndex - startIndex + 1);
+    if (inRangeCount > 0)
+      fill_internal(colors, inRangeCount, startIndex, maxIndex);
+    if (inRangeCount < count)
+    {
+      const uint32_t lastColor = get_color_internal(maxIndex, maxIndex);
+      for (uint16_t i = inRangeCount; i < count; ++i)
+        colors[i] = lastColor;
+    }
+  }
+
+  /**
+   * \brief true if the color is the same for all indexes
+   */
+  virtual bool is_index_invariant() const { return false; }
+
   /**
    * \brief reset the color
    */
@@ -34,6 +66,15 @@ public:
 
 private:
   virtual uint32_t get_color_internal(const uint16_t index = 0, const uint16_t maxIndex = 0) const = 0;
+
+protected:
+  // indexes are in [0, maxIndex], override to step through the indexes incrementally
+  virtual void fill_internal(uint32_t* colors, const uint16_t count, const uint16_t startIndex, const uint16_t maxIndex)
+          const
+  {
+    for (uint16_t i = 0; i < count; ++i)
+      colors[i] = get_color_internal(startIndex + i, maxIndex);
+  }
 };
 
 /**
@@ -79,6 +120,8 @@ public:
 
   uint32_t get_color_internal(const uint16_t index = 0, const uint16_t maxIndex = 0) const override;
 
+  bool is_index_invariant() const override { return true; }
+
   void reset() override {};
 
 private:
@@ -96,6 +139,10 @@ public:
   uint32_t get_color_internal(const uint16_t index, const uint16_t maxIndex) const override;
 
   void reset() override {};
+
+private:
+  void fill_internal(uint32_t* colors, const uint16_t count, const uint16_t startIndex, const uint16_t maxIndex)
+          const override;
 };
 
 /**
@@ -113,6 +160,9 @@ public:
   void reset() override {};
 
 private:
+  void fill_internal(uint32_t* colors, const uint16_t count, const uint16_t startIndex, const uint16_t maxIndex)
+          const override;
+
   uint32_t _colorStart;
   uint32_t _colorEnd;
 };
@@ -153,6 +203,9 @@ private:
    */
   void internal_update(const uint32_t deltaTimeMilli) override { _firstPixelHue += _increment; };
 
+  void fill_internal(uint32_t* colors, const uint16_t count, const uint16_t startIndex, const uint16_t maxIndex)
+          const override;
+
   uint32_t _increment;
   uint16_t _firstPixelHue;
 };
@@ -181,6 +234,9 @@ private:
    */
   void internal_update(const uint32_t deltaTimeMilli) override { _index += _increment; };
 
+  void fill_internal(uint32_t* colors, const uint16_t count, const uint16_t startIndex, const uint16_t maxIndex)
+          const override;
+
   uint8_t _increment;
   uint16_t _index;
   const palette_t* _paletteRef;
@@ -193,36 +249,64 @@ private:
 class GeneratePaletteStep : public DynamicColor
 {
 public:
-  GeneratePaletteStep(const palette_t& palette) : _index(0), _paletteRef(&palette) {}
+  GeneratePaletteStep(const palette_t& palette) : _index(0), _paletteRef(&palette) { update_color(); }
 
-  uint32_t get_color_internal(const uint16_t index, const uint16_t maxIndex) const override;
+  // computed once per update
+  uint32_t get_color_internal(const uint16_t index, const uint16_t maxIndex) const override { return _color; }
 
-  void reset() override { _index = 0; };
+  bool is_index_invariant() const override { return true; }
+
+  void reset() override
+  {
+    _index = 0;
+    update_color();
+  };
 
 private:
   /**
    * \brief Call when you want the animation to progress
    */
-  void internal_update(const uint32_t deltaTimeMilli) override { _index += 1; };
+  void internal_update(const uint32_t deltaTimeMilli) override
+  {
+    _index += 1;
+    update_color();
+  };
+
+  void update_color();
 
   uint8_t _index;
   const palette_t* _paletteRef;
+  uint32_t _color;
 };
 
 class GeneratePaletteIndexed : public IndexedColor
 {
 public:
-  GeneratePaletteIndexed(const palette_t& palette) : _index(0), _paletteRef(&palette) {}
+  GeneratePaletteIndexed(const palette_t& palette) : _index(0), _paletteRef(&palette) { update_color(); }
 
-  uint32_t get_color_internal(const uint16_t index, const uint16_t maxIndex) const override;
+  // computed once per update
+  uint32_t get_color_internal(const uint16_t index, const uint16_t maxIndex) const override { return _color; }
 
-  void update(const uint8_t index) override { _index = index; }
+  bool is_index_invariant() const override { return true; }
 
-  void reset() override { _index = 0; };
+  void update(const uint8_t index) override
+  {
+    _index = index;
+    update_color();
+  }
+
+  void reset() override
+  {
+    _index = 0;
+    update_color();
+  };
 
 private:
+  void update_color();
+
   uint8_t _index;
   const palette_t* _paletteRef;
+  uint32_t _color;
 };
 
 /**
@@ -235,20 +319,35 @@ public:
   GenerateRainbowPulse(const uint8_t colorDivisions) : _currentPixelHue(0)
   {
     _increment = max(float(UINT16_MAX) / float(colorDivisions), 1);
+    update_color();
   }
 
-  uint32_t get_color_internal(const uint16_t index, const uint16_t maxIndex) const override;
+  // computed once per update
+  uint32_t get_color_internal(const uint16_t index, const uint16_t maxIndex) const override { return _color; }
 
-  void reset() override { _currentPixelHue = 0; };
+  bool is_index_invariant() const override { return true; }
+
+  void reset() override
+  {
+    _currentPixelHue = 0;
+    update_color();
+  };
 
 private:
   /**
    * \brief Call when you want the animation to progress
    */
-  void internal_update(const uint32_t deltaTimeMilli) override { _currentPixelHue += _increment; };
+  void internal_update(const uint32_t deltaTimeMilli) override
+  {
+    _currentPixelHue += _increment;
+    update_color();
+  };
+
+  void update_color();
 
   uint16_t _increment;
   uint16_t _currentPixelHue;
+  uint32_t _color;
 };
 
 class GenerateRainbowIndex : public IndexedColor
@@ -258,17 +357,32 @@ public:
     _increment(UINT16_MAX / float(colorDivisions)),
     _currentPixelHue(0)
   {
+    update_color();
   }
 
-  uint32_t get_color_internal(const uint16_t index, const uint16_t maxIndex) const override;
+  // computed once per update
+  uint32_t get_color_internal(const uint16_t index, const uint16_t maxIndex) const override { return _color; }
+
+  bool is_index_invariant() const override { return true; }
 
-  void update(const uint8_t index) override { _currentPixelHue = float(index) * _increment; }
+  void update(const uint8_t index) override
+  {
+    _currentPixelHue = float(index) * _increment;
+    update_color();
+  }
 
-  void reset() override { _currentPixelHue = 0; };
+  void reset() override
+  {
+    _currentPixelHue = 0;
+    update_color();
+  };
 
 private:
+  void update_color();
+
   float _increment;
   uint16_t _currentPixelHue;
+  uint32_t _color;
 };
 
 // generate a rainbow with pastel colors
@@ -278,20 +392,35 @@ public:
   GeneratePastelPulse(const uint8_t colorDivisions) : _currentPixelHue(0)
   {
     _increment = max(float(UINT16_MAX) / float(colorDivisions), 1);
+    update_color();
   }
 
-  uint32_t get_color_internal(const uint16_t index, const uint16_t maxIndex) const override;
+  // computed once per update
+  uint32_t get_color_internal(const uint16_t index, const uint16_t maxIndex) const override { return _color; }
+
+  bool is_index_invariant() const override { return true; }
 
-  void reset() override { _currentPixelHue = 0; };
+  void reset() override
+  {
+    _currentPixelHue = 0;
+    update_color();
+  };
 
 private:
   /**
    * \brief Call when you want the animation to progress
    */
-  void internal_update(const uint32_t deltaTimeMilli) override { _currentPixelHue += _increment; };
+  void internal_update(const uint32_t deltaTimeMilli) override
+  {
+    _currentPixelHue += _increment;
+    update_color();
+  };
+
+  void update_color();
 
   uint16_t _increment;
   uint16_t _currentPixelHue;
+  uint32_t _color;
 };
 
 /**
@@ -304,6 +433,8 @@ public:
 
   uint32_t get_color_internal(const uint16_t index, const uint16_t maxIndex) const override { return _color; }
 
+  bool is_index_invariant() const override { return true; }
+
   void reset() override {};
 
 private:
@@ -325,6 +456,8 @@ public:
 
   uint32_t get_color_internal(const uint16_t index, const uint16_t maxIndex) const override { return _color; }
 
+  bool is_index_invariant() const override { return true; }
+
   void reset() override { internal_update(0); };
 
 private:
@@ -0,0 +1,70 @@
+#ifndef PALETTE_CACHE_H
+#define PALETTE_CACHE_H
+
+#include <array>
+#include <cstdint>
+
+namespace utils {
+
+/**
+ * \brief Table of all the colors of a 16-entry palette, at a given brightness
+ *
+ * The table is expanded once by update(), and only expanded again when the
+ * palette or the brightness changes. Colors are then read with get(), a single
+ * load per pixel instead of a palette interpolation.
+ *
+ * With a uint16_t index, the table has 1024 entries (the 6 lowest bits of the
+ * index are ignored).
+ */
+template<typename UIntTy = uint8_t> class PaletteCache
+{
+public:
+  using PaletteTy = std::array<uint32_t, 16>;
+
+  static constexpr uint16_t size = (sizeof(UIntTy) == 1) ? 256 : 1024;
+  static constexpr uint8_t indexShift = (sizeof(UIntTy) == 1) ? 0 : 6;
+
+  static_assert(sizeof(UIntTy) <= 2, "uint8_t or uint16_t index required");
+
+  /**
+   * \brief Expand \p palette at \p brightness, if it changed since the last call
+   * \param[in] lookup the palette function to cache, called as lookup(index, palette, brightness)
+   * \return true if the table was expanded again
+   */
+  template<typename LookupTy> bool update(const PaletteTy& palette, const uint8_t brightness, LookupTy lookup)
+  {
+    if (_paletteRef == &palette and _brightness == brightness and _palette == palette)
+      return false;
+
+    _paletteRef = &palette;
+    _palette = palette;
+    _brightness = brightness;
+    for (uint16_t i = 0; i < size; ++i)
+    {
+      _table[i] = lookup(static_cast<UIntTy>(i << indexShift), palette, brightness);
+    }
+    return true;
+  }
+
+  /// True if the table was last expanded from \p palette at \p brightness (content is not checked)
+  bool holds(const PaletteTy& palette, const uint8_t brightness) const
+  {
+    return _paletteRef == &palette and _brightness == brightness;
+  }
+
+  /// Force the next update() to expand the table
+  void invalidate() { _paletteRef = nullptr; }
+
+  /// Color of the palette at \p index
+  uint32_t get(const UIntTy index) const { return _table[index >> indexShift]; }
+
+private:
+  std::array<uint32_t, size> _table;
+  PaletteTy _palette;
+  const PaletteTy* _paletteRef = nullptr;
+  uint8_t _brightness = 0;
+};
+
+} // namespace utils
+
+#endif
@@ -5,6 +5,8 @@
 
 #include <cstdint>
 
+#include "src/compile.h"
+#include "src/system/utils/color_kernels.h"
 #include "src/system/utils/utils.h"
 
 /// Cloudy color palette/ blue to blue-white
@@ -204,6 +206,27 @@ const palette_t PaletteAuroraColors = {0x000000,
 
 uint32_t get_color_from_palette(const uint8_t index, const palette_t& palette, const uint8_t brightness)
 {
+#ifdef LMBD_FIXED_POINT_COLORS
+  const uint8_t renormIndex = index >> 4;  // convert to [0; 15] (divide by 16)
+  const uint8_t blendIndex = index & 0x0F; // blend factor, in 16th
+
+  const uint32_t entry = palette[renormIndex];
+  uint32_t rgb = entry & 0x00ffffff;
+
+  // bit-exact with the float version below
+  if (blendIndex != 0)
+  {
+    const uint32_t nextEntry = palette[(renormIndex + 1) % PALETTE_SIZE];
+    rgb = utils::kernels::interpolate(rgb, nextEntry & 0x00ffffff, blendIndex << 4);
+  }
+
+  if (brightness != 255)
+  {
+    rgb = (brightness != 0) ? utils::kernels::scale_lit(rgb, brightness) : 0;
+  }
+
+  return (entry & 0xff000000) | rgb;
+#else
   const uint8_t renormIndex = index >> 4;  // convert to [0; 15] (divide by 16)
   const uint8_t blendIndex = index & 0x0F; // mask with 15 (get the less significant part, that will
                                            // be the blend factor)
@@ -286,10 +309,12 @@ uint32_t get_color_from_palette(const uint8_t index, const palette_t& palette, c
   color.blue = blue1;
   // return color code
   return color.color;
+#endif
 }
 
 uint32_t get_color_from_palette(const uint16_t index, const palette_t& palette, const uint8_t brightness)
 {
+  // (no integer version: the float weights below cannot be reproduced bit-exact)
   const float ramp = (index / (float)UINT16_MAX) * PALETTE_SIZE;
 
   const uint8_t renormIndex = min(floor(ramp), PALETTE_SIZE - 1);        // convert to [0; 15] (divide by 16)
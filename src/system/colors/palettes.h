@@ -7,6 +7,8 @@
 #include <array>
 #include <cstdint>
 
+#include "src/system/colors/palette_cache.h"
+
 static constexpr uint8_t PALETTE_SIZE = 16;
 using palette_t = std::array<uint32_t, PALETTE_SIZE>;
 
@@ -259,6 +261,21 @@ extern const palette_t PaletteAuroraColors;
 uint32_t get_color_from_palette(const uint8_t index, const palette_t& palette, const uint8_t brightness = 255);
 uint32_t get_color_from_palette(const uint16_t index, const palette_t& palette, const uint8_t brightness = 255);
 
+/**
+ * \brief Expand \p palette in \p cache, only if palette or brightness changed
+ * \param[in] cache The table to update, then read with cache.get(index)
+ * \param[in] palette The palette to sample from
+ * \param[in] brightness The brighness of the colors, default is max at 255
+ * \return true if the table was expanded again
+ */
+template<typename UIntTy>
+bool update_palette_cache(utils::PaletteCache<UIntTy>& cache, const palette_t& palette, const uint8_t brightness = 255)
+{
+  return cache.update(palette, brightness, [](const UIntTy index, const palette_t& p, const uint8_t b) {
+    return get_color_from_palette(index, p, b);
+  });
+}
+
 #endif
 
 #endif
@@ -7,6 +7,7 @@
 #include "src/system/utils/coordinates.h"
 #include "src/system/utils/constants.h"
 #include "src/system/utils/utils.h"
+#include "src/system/ext/math8.h"
 
 #include "src/system/utils/print.h"
 
@@ -23,73 +24,97 @@ static constexpr float speedDampening = 0.92; // low speed dampening [0-0.99] at
 static constexpr float maxAngularSpeed_radS = 4 * c_TWO_PI;
 static constexpr float maxVerticalSpeed_mmS = 50;
 
-struct Particle
+/**
+ * \brief Contrain a position to the cylinder, limiting the movement at the extremities
+ * \return the led index of the constrained position
+ */
+static inline int16_t constraint_into_lamp_body(const float theta_rad, float& z_mm, float& zSpeed_mS)
 {
-  Particle() : thetaSpeed_radS(0.0), zSpeed_mS(0.0), theta_rad(0.0), z_mm(0.0) {}
+  int16_t lampIndex = to_led_index_no_bounds(theta_rad, z_mm);
 
-  Particle(const vec3d& positionCartesian) :
-    thetaSpeed_radS(0.0),
-    zSpeed_mS(0.0),
-    theta_rad(atan2(positionCartesian.y, positionCartesian.x)),
-    z_mm(positionCartesian.z)
+  // coordinates go from 0 to -max
+  if (z_mm > 0)
   {
-    _savedLampIndex = to_lamp_index_no_bounds();
+    z_mm = 0;
+    zSpeed_mS = -zSpeed_mS * reboundCoeff;
+    lampIndex = to_led_index_no_bounds(theta_rad, z_mm);
   }
 
-  Particle(const float positionTheta_rad, const float positionZ_mm) :
-    thetaSpeed_radS(0.0),
-    zSpeed_mS(0.0),
-    theta_rad(positionTheta_rad),
-    z_mm(positionZ_mm)
+  if (z_mm < -lampHeight)
   {
-    _savedLampIndex = to_lamp_index_no_bounds();
+    z_mm = -lampHeight;
+    zSpeed_mS = -zSpeed_mS * reboundCoeff;
+    lampIndex = to_led_index_no_bounds(theta_rad, z_mm);
   }
 
-  Particle(const Particle& other) :
-    thetaSpeed_radS(other.thetaSpeed_radS),
-    zSpeed_mS(other.zSpeed_mS),
-    theta_rad(other.theta_rad),
-    z_mm(other.z_mm),
-    _savedLampIndex(other._savedLampIndex)
+  // handle the real limits (led strip do not start and end at zero depth)
+  if (not is_led_index_valid(lampIndex))
   {
+    // we are too high above the first led
+    if (z_mm >= 0)
+    {
+      // go one unit lower
+      z_mm = ledStripWidth_mm * 1.5;
+      zSpeed_mS = -zSpeed_mS * reboundCoeff;
+    }
+    else
+    {
+      // go one unit above
+      z_mm = -lampHeight + ledStripWidth_mm * 1.5;
+      zSpeed_mS = -zSpeed_mS * reboundCoeff;
+    }
+    // udpate index
+    lampIndex = to_led_index_no_bounds(theta_rad, z_mm);
   }
+  return lampIndex;
+}
 
-  vec2d compute_speed_increment(const vec3d& accelerationCartesian_m, const float delaTime) const
+/**
+ * \brief Acceleration of one simulation step, shared by all the particles
+ *
+ * Only the projection on the cylinder surface is kept: at angle theta, the
+ * angular speed increment of a step is angularSpeedGain.R².dt.(cos(theta).ay - sin(theta).ax),
+ * the vertical speed increment is linearSpeedGain.az.dt
+ */
+struct ParticleStep
+{
+  ParticleStep(const vec3d& accelerationCartesian_m, const float _deltaTime) :
+    deltaTime(_deltaTime),
+    angularX(-accelerationCartesian_m.x * angularStepGain * _deltaTime),
+    angularY(accelerationCartesian_m.y * angularStepGain * _deltaTime),
+    verticalIncrement(linearSpeedGain * accelerationCartesian_m.z * _deltaTime)
   {
-    // speed vector on radial (derivative of cartesian to cylinder coordinates for theta)
-    const vec3d e_theta(-sin(theta_rad) * cylinderRadius_m, cos(theta_rad) * cylinderRadius_m, 0);
-    // speed vector on z (derivative of cartesian to cylinder coordinates for z)
-    const vec3d e_z(0, 0, 1);
-    // ignore the radius derivative, as we want to stay on the cylinder surface
-
-    // compute the speed vector on cylinder surface
-    const vec3d& tangantialVector = e_theta.multiply(accelerationCartesian_m.dot(e_theta));
-    const vec3d& directVector = e_z.multiply(accelerationCartesian_m.dot(e_z));
-    const vec3d& accelerationVector = tangantialVector.add(directVector);
-
-    return vec2d(angularSpeedGain * accelerationVector.dot(e_theta) / static_cast<float>(cylinderRadius_m) * delaTime,
-                 linearSpeedGain * accelerationVector.dot(e_z) * delaTime);
   }
 
   /**
-   * \brief apply a cartesian acceleration to this particulate
+   * \brief Apply this step to the particle of speeds (\p thetaSpeed_radS, \p zSpeed_mS) at (\p theta_rad, \p z_mm)
+   * \return the led index of the new position
    */
-  void apply_acceleration(const vec3d& accelerationCartesian_m, const float delaTime, const bool shouldContrain = true)
+  int16_t integrate(float& thetaSpeed_radS,
+                    float& zSpeed_mS,
+                    float& theta_rad,
+                    float& z_mm,
+                    const bool shouldContrain = true) const
   {
-    const auto& speedIncrement = compute_speed_increment(accelerationCartesian_m, delaTime);
+    // tangential acceleration, from the angle lookup table
+    const uint16_t angle16 = static_cast<int32_t>(theta_rad * (UINT16_MAX / c_TWO_PI));
+    const float angularIncrement = (cos16(angle16) * angularY + sin16(angle16) * angularX) / INT16_MAX;
+
     // start by dampening the speed
-    dampen_speed(speedDampening);
+    thetaSpeed_radS *= speedDampening;
+    zSpeed_mS *= speedDampening;
 
     // update speed
-    thetaSpeed_radS = lmpd_constrain(thetaSpeed_radS + speedIncrement.x, -maxAngularSpeed_radS, maxAngularSpeed_radS);
-    zSpeed_mS = lmpd_constrain(zSpeed_mS + speedIncrement.y, -maxVerticalSpeed_mmS, maxVerticalSpeed_mmS);
+    thetaSpeed_radS = lmpd_constrain(thetaSpeed_radS + angularIncrement, -maxAngularSpeed_radS, maxAngularSpeed_radS);
+    zSpeed_mS = lmpd_constrain(zSpeed_mS + verticalIncrement, -maxVerticalSpeed_mmS, maxVerticalSpeed_mmS);
 
     static constexpr float angularUnit = stripXCoordinates / c_TWO_PI;
     static constexpr float verticalUnit = ledStripWidth_mm * 1.5;
 
     // update position (limit speed to pixel unit per dt)
-    const float angularPositionIncrement = lmpd_constrain(thetaSpeed_radS * delaTime, -angularUnit, angularUnit);
-    const float verticalPositionIncrement = lmpd_constrain(zSpeed_mS * delaTime, -verticalUnit, verticalUnit) * 1000.0;
+    const float angularPositionIncrement = lmpd_constrain(thetaSpeed_radS * deltaTime, -angularUnit, angularUnit);
+    const float verticalPositionIncrement =
+            lmpd_constrain(zSpeed_mS * deltaTime, -verticalUnit, verticalUnit) * 1000.0;
 
     // update particle position
     z_mm += verticalPositionIncrement;
@@ -100,63 +125,63 @@ struct Particle
 
     // constrain to the lamp body
     if (shouldContrain)
-      constraint_into_lamp_body();
-    else
-      _savedLampIndex = to_lamp_index_no_bounds();
+      return constraint_into_lamp_body(theta_rad, z_mm, zSpeed_mS);
+    return to_led_index_no_bounds(theta_rad, z_mm);
   }
 
-  Particle simulate_after_acceleration(const vec3d& accelerationCartesian_m,
-                                       const float delaTime,
-                                       const bool shouldContrain = true) const
+  // angular speed increment is (cos(theta) * angularY + sin(theta) * angularX)
+  static constexpr float angularStepGain = angularSpeedGain * cylinderRadius_m * cylinderRadius_m;
+
+  float deltaTime;
+  float angularX;
+  float angularY;
+  float verticalIncrement;
+};
+
+struct Particle
+{
+  Particle() : thetaSpeed_radS(0.0), zSpeed_mS(0.0), theta_rad(0.0), z_mm(0.0) {}
+
+  Particle(const vec3d& positionCartesian) :
+    thetaSpeed_radS(0.0),
+    zSpeed_mS(0.0),
+    theta_rad(atan2(positionCartesian.y, positionCartesian.x)),
+    z_mm(positionCartesian.z)
   {
-    Particle simulated(*this);
-    simulated.apply_acceleration(accelerationCartesian_m, delaTime, shouldContrain);
-    return simulated;
+    _savedLampIndex = to_lamp_index_no_bounds();
   }
 
-  /**
-   * \brief Contrain the particle movement to the cylinder, limiting the movement at the extremities
-   */
-  void constraint_into_lamp_body()
+  Particle(const float positionTheta_rad, const float positionZ_mm) :
+    thetaSpeed_radS(0.0),
+    zSpeed_mS(0.0),
+    theta_rad(positionTheta_rad),
+    z_mm(positionZ_mm)
   {
     _savedLampIndex = to_lamp_index_no_bounds();
+  }
 
-    // coordinates go from 0 to -max
-    if (z_mm > 0)
-    {
-      z_mm = 0;
-      zSpeed_mS = -zSpeed_mS * reboundCoeff;
-      _savedLampIndex = to_lamp_index_no_bounds();
-    }
-
-    if (z_mm < -lampHeight)
-    {
-      z_mm = -lampHeight;
-      zSpeed_mS = -zSpeed_mS * reboundCoeff;
-      _savedLampIndex = to_lamp_index_no_bounds();
-    }
+  Particle(const Particle& other) :
+    thetaSpeed_radS(other.thetaSpeed_radS),
+    zSpeed_mS(other.zSpeed_mS),
+    theta_rad(other.theta_rad),
+    z_mm(other.z_mm),
+    _savedLampIndex(other._savedLampIndex)
+  {
+  }
 
-    // handle the real limits (led strip do not start and end at zero depth)
-    if (not is_led_index_valid(_savedLampIndex))
-    {
-      // we are too high above the first led
-      if (z_mm >= 0)
-      {
-        // go one unit lower
-        z_mm = ledStripWidth_mm * 1.5;
-        zSpeed_mS = -zSpeed_mS * reboundCoeff;
-      }
-      else
-      {
-        // go one unit above
-        z_mm = -lampHeight + ledStripWidth_mm * 1.5;
-        zSpeed_mS = -zSpeed_mS * reboundCoeff;
-      }
-      // udpate index
-      _savedLampIndex = to_lamp_index_no_bounds();
-    }
+  /**
+   * \brief apply the acceleration of a simulation step to this particulate
+   */
+  void apply_step(const ParticleStep& step, const bool shouldContrain = true)
+  {
+    _savedLampIndex = step.integrate(thetaSpeed_radS, zSpeed_mS, theta_rad, z_mm, shouldContrain);
   }
 
+  /**
+   * \brief Contrain the particle movement to the cylinder, limiting the movement at the extremities
+   */
+  void constraint_into_lamp_body() { _savedLampIndex = ::constraint_into_lamp_body(theta_rad, z_mm, zSpeed_mS); }
+
   void dampen_speed(const float dampenFactor)
   {
     thetaSpeed_radS *= dampenFactor;
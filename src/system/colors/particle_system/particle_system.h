@@ -3,15 +3,66 @@
 #ifndef PARTICLE_SYSTEM_H
 #define PARTICLE_SYSTEM_H
 
+#include <cassert>
 #include <cstdint>
-#include <functional>
-#include <set>
 
 #include "src/system/ext/random8.h"
 #include "src/system/colors/colors.h"
 
 #include "src/system/colors/particle_system/particle.h"
 
+/**
+ * \brief One bit per LED index, to store the occupied spaces without allocation
+ * Covers the lamp body plus the spawn areas above and below it. Only these
+ * positions can be set (asserted, so no collision is ever dropped): particles
+ * are spawned there, and the colliding ones are kept in the lamp body. Out of
+ * these bounds is_set is false and reset does nothing, for the particles that
+ * fell away from the lamp.
+ */
+class OccupancyMap
+{
+public:
+  void clear()
+  {
+    for (uint32_t& word: words)
+      word = 0;
+  }
+
+  bool is_set(const int16_t pos) const
+  {
+    if (not is_tracked(pos))
+      return false;
+    const uint16_t bit = pos + margin;
+    return (words[bit / 32] >> (bit % 32)) & 1;
+  }
+
+  void set(const int16_t pos)
+  {
+    assert(is_tracked(pos));
+    if (not is_tracked(pos))
+      return;
+    const uint16_t bit = pos + margin;
+    words[bit / 32] |= 1u << (bit % 32);
+  }
+
+  void reset(const int16_t pos)
+  {
+    if (not is_tracked(pos))
+      return;
+    const uint16_t bit = pos + margin;
+    words[bit / 32] &= ~(1u << (bit % 32));
+  }
+
+private:
+  // particles spawn up to two turns away from the lamp body
+  static constexpr int16_t margin = static_cast<int16_t>(2 * stripXCoordinates) + 1;
+  static constexpr uint16_t bitCount = LED_COUNT + 2 * margin;
+
+  static bool is_tracked(const int16_t pos) { return pos >= -margin and pos < LED_COUNT + margin; }
+
+  uint32_t words[(bitCount + 31) / 32] = {};
+};
+
 /**
  * \brief Define a particle system
  * ALL PARTICLE SYSTEM SHARE THE SAME PÄRTICLE SUBSET
@@ -26,7 +77,7 @@ public:
    */
   void reset()
   {
-    occupiedSpacesSet.clear();
+    occupiedSpaces.clear();
     for (size_t i = 0; i < ParticleSystem::maxParticuleCount; ++i)
     {
       isAllocated[i] = false;
@@ -43,9 +94,13 @@ public:
     reset();
   }
 
-  void init_particules(const std::function<int16_t(size_t)>& positionGeneratorFunction)
+  /**
+   * \brief Spawn all the particules
+   * \param[in] positionGeneratorFunction callable (size_t index) -> int16_t led index
+   */
+  template<typename PositionGenerator> void init_particules(const PositionGenerator& positionGeneratorFunction)
   {
-    occupiedSpacesSet.clear();
+    occupiedSpaces.clear();
     for (size_t i = 0; i < particuleCount; ++i)
     {
       isAllocated[i] = false;
@@ -53,8 +108,12 @@ public:
     }
   }
 
-  void init_deferred_particules(uint8_t maxParticlesToPop,
-                                const std::function<int16_t(size_t)>& positionGeneratorFunction)
+  /**
+   * \brief Spawn up to maxParticlesToPop particules, in the free slots
+   * \param[in] positionGeneratorFunction callable (size_t index) -> int16_t led index
+   */
+  template<typename PositionGenerator>
+  void init_deferred_particules(uint8_t maxParticlesToPop, const PositionGenerator& positionGeneratorFunction)
   {
     for (size_t i = 0; i < particuleCount and maxParticlesToPop > 0; ++i)
     {
@@ -72,15 +131,15 @@ public:
                              const float deltaTime,
                              const bool shouldContrain = true)
   {
+    const ParticleStep step(accelerationCartesian, deltaTime);
     for (size_t i = 0; i < particuleCount; ++i)
     {
       // do not iterate non allocated particles
       if (not isAllocated[i])
         continue;
 
-      Particle& p = particules[i];
       // apply force and constrain
-      p.apply_acceleration(accelerationCartesian, deltaTime, shouldContrain);
+      lampIndexes[i] = step.integrate(thetaSpeeds_radS[i], zSpeeds_mS[i], thetas_rad[i], zs_mm[i], shouldContrain);
     }
   }
 
@@ -88,47 +147,55 @@ public:
                                const float deltaTime,
                                const bool shouldContrain = true)
   {
+    const ParticleStep step(accelerationCartesian, deltaTime);
     for (size_t i = 0; i < particuleCount; ++i)
     {
       // do not iterate non allocated particles
       if (not isAllocated[i])
         continue;
 
-      Particle& p = particules[i];
-      const int16_t ledIndex = p._savedLampIndex;
+      const int16_t ledIndex = lampIndexes[i];
 
       // simulate instead of updating directly
-      Particle newP = p.simulate_after_acceleration(accelerationCartesian, deltaTime, shouldContrain);
+      float thetaSpeed_radS = thetaSpeeds_radS[i];
+      float zSpeed_mS = zSpeeds_mS[i];
+      float theta_rad = thetas_rad[i];
+      float z_mm = zs_mm[i];
+      const int16_t newLedIndex = step.integrate(thetaSpeed_radS, zSpeed_mS, theta_rad, z_mm, shouldContrain);
 
       // update particle position in occupation set
-      const int16_t newLedIndex = newP._savedLampIndex;
       if (newLedIndex != ledIndex)
       {
         // check collision : no collision
         if (not is_position_taken(newLedIndex))
         {
-          occupiedSpacesSet.erase(ledIndex);
-          occupiedSpacesSet.insert(newLedIndex);
+          occupiedSpaces.reset(ledIndex);
+          occupiedSpaces.set(newLedIndex);
         }
         // check collision : collision !!
         else
         {
           // refuse movement, rebound speed
-          p.thetaSpeed_radS = -p.thetaSpeed_radS * 0.75;
-          p.zSpeed_mS = -p.zSpeed_mS * 0.75;
+          thetaSpeeds_radS[i] = -thetaSpeeds_radS[i] * 0.75;
+          zSpeeds_mS[i] = -zSpeeds_mS[i] * 0.75;
           continue;
         }
       }
 
       // update particle
-      p = newP;
+      thetaSpeeds_radS[i] = thetaSpeed_radS;
+      zSpeeds_mS[i] = zSpeed_mS;
+      thetas_rad[i] = theta_rad;
+      zs_mm[i] = z_mm;
+      lampIndexes[i] = newLedIndex;
     }
   }
 
   /**
    * \brief Filter particles depending on condition
+   * \param[in] positionGeneratorFunction callable (const Particle&) -> bool, true to depop
    */
-  void depop_particules(const std::function<bool(const Particle&)>& positionGeneratorFunction)
+  template<typename DepopCondition> void depop_particules(const DepopCondition& positionGeneratorFunction)
   {
     for (size_t i = 0; i < particuleCount; ++i)
     {
@@ -136,11 +203,10 @@ public:
       if (not isAllocated[i])
         continue;
 
-      auto& parti = particules[i];
-      if (positionGeneratorFunction(parti))
+      if (positionGeneratorFunction(load_particule(i)))
       {
         isAllocated[i] = false;
-        occupiedSpacesSet.erase(parti._savedLampIndex);
+        occupiedSpaces.reset(lampIndexes[i]);
       }
     }
   }
@@ -153,16 +219,17 @@ public:
       if (not isAllocated[i])
         continue;
 
-      const auto& index = particules[i]._savedLampIndex;
+      const int16_t index = lampIndexes[i];
       if (is_led_index_valid(index))
         strip.setPixelColor(index, color.get_color(i % maxColorIndex, maxColorIndex));
     }
   }
 
 protected:
-  bool is_position_taken(const int16_t pos) const { return occupiedSpacesSet.find(pos) != occupiedSpacesSet.cend(); }
+  bool is_position_taken(const int16_t pos) const { return occupiedSpaces.is_set(pos); }
 
-  void spawn_particule(const size_t index, const std::function<int16_t(size_t)>& positionGeneratorFunction)
+  template<typename PositionGenerator>
+  void spawn_particule(const size_t index, const PositionGenerator& positionGeneratorFunction)
   {
     int16_t pos = positionGeneratorFunction(index);
     int maxTries = 3;
@@ -172,16 +239,41 @@ protected:
       maxTries--;
     }
     // generate start position from user function
-    particules[index] = Particle(to_lamp_unconstraint(pos));
-    occupiedSpacesSet.insert(pos);
+    store_particule(index, Particle(to_lamp_unconstraint(pos)));
+    occupiedSpaces.set(pos);
     isAllocated[index] = true;
   }
 
+  Particle load_particule(const size_t index) const
+  {
+    Particle p;
+    p.thetaSpeed_radS = thetaSpeeds_radS[index];
+    p.zSpeed_mS = zSpeeds_mS[index];
+    p.theta_rad = thetas_rad[index];
+    p.z_mm = zs_mm[index];
+    p._savedLampIndex = lampIndexes[index];
+    return p;
+  }
+
+  void store_particule(const size_t index, const Particle& p)
+  {
+    thetaSpeeds_radS[index] = p.thetaSpeed_radS;
+    zSpeeds_mS[index] = p.zSpeed_mS;
+    thetas_rad[index] = p.theta_rad;
+    zs_mm[index] = p.z_mm;
+    lampIndexes[index] = p._savedLampIndex;
+  }
+
 private:
   static constexpr uint16_t maxParticuleCount = 512;
-  Particle particules[maxParticuleCount];
+  // particules, stored per field to iterate on contiguous values
+  float thetaSpeeds_radS[maxParticuleCount];
+  float zSpeeds_mS[maxParticuleCount];
+  float thetas_rad[maxParticuleCount];
+  float zs_mm[maxParticuleCount];
+  int16_t lampIndexes[maxParticuleCount];
   bool isAllocated[maxParticuleCount]; // store the allocated particules flag
-  std::set<int16_t> occupiedSpacesSet; // store the occupied spaces
+  OccupancyMap occupiedSpaces;         // store the occupied spaces
 
   // forced to be less than maxParticuleCount
   uint16_t particuleCount;
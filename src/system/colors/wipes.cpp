@@ -37,14 +37,14 @@ bool dot_wipe_down(const Color& color,
   if (targetIndex < LED_COUNT)
   {
     strip.fadeToBlackBy(fadeOut);
-    // increment
-    for (uint32_t increment = LED_COUNT / ceil(duration / delay); increment > 0; increment--)
-    {
-      strip.setPixelColor(targetIndex, color.get_color(targetIndex, LED_COUNT));
-      targetIndex += 1;
-      if (targetIndex >= endIndex or targetIndex >= LED_COUNT)
-        break;
-    }
+    // increment, stop after the last index
+    const uint32_t increment = LED_COUNT / ceil(duration / delay);
+    const uint16_t lastIndex = min(endIndex, LED_COUNT);
+    const uint16_t count = min(increment, (targetIndex + 1 < lastIndex) ? lastIndex - targetIndex : 1);
+    strip.write_span(targetIndex, count, [&](uint32_t* out, uint16_t written) {
+      color.fill(out, written, targetIndex, LED_COUNT);
+    });
+    targetIndex += count;
   }
 
   return targetIndex >= endIndex or targetIndex >= LED_COUNT;
@@ -75,14 +75,14 @@ bool dot_wipe_up(const Color& color,
   if (targetIndex < LED_COUNT)
   {
     strip.fadeToBlackBy(fadeOut);
-    // increment
-    for (uint32_t increment = LED_COUNT / ceil(duration / delay); increment > 0; increment--)
-    {
-      strip.setPixelColor(targetIndex, color.get_color(targetIndex, LED_COUNT));
-      targetIndex -= 1;
-      if (targetIndex == UINT16_MAX or targetIndex <= endIndex)
-        return true;
-    }
+    // increment, stop after the index above the end index (or 0)
+    const uint32_t increment = LED_COUNT / ceil(duration / delay);
+    const uint16_t count = min(increment, (targetIndex > endIndex + 1) ? targetIndex - endIndex : 1);
+    const uint16_t firstIndex = targetIndex + 1 - count;
+    strip.write_span(firstIndex, count, [&](uint32_t* out, uint16_t written) {
+      color.fill(out, written, firstIndex, LED_COUNT);
+    });
+    targetIndex -= count;
   }
 
   return targetIndex == UINT16_MAX or targetIndex <= endIndex;
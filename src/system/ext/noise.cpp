@@ -390,6 +390,159 @@ uint8_t inoise_octaves(uint16_t x, uint8_t octaves, int scale, uint16_t time)
   return noise;
 }
 
+// write the noise of an octave in a grid cell (first octave overwrites it)
+static inline void write_octave(uint8_t& out, const int8_t raw, const uint8_t octave)
+{
+  int8_t n = raw + 64;               //   0..128
+  const uint8_t value = qadd8(n, n); //   0..255
+  out = (octave == 0) ? value : qadd8(out, value >> octave);
+}
+
+static void fill_noise_2d_octave(uint8_t* data,
+                                 const uint16_t width,
+                                 const uint16_t height,
+                                 const uint16_t x,
+                                 const uint16_t xScale,
+                                 uint16_t y,
+                                 const uint16_t yScale,
+                                 const uint8_t octave)
+{
+  const uint8_t N = 0x80;
+
+  for (uint16_t j = 0; j < height; ++j, y += yScale)
+  {
+    // shared by the whole row
+    const uint8_t Y = y >> 8;
+    const int8_t yy = ((uint8_t)(y) >> 1) & 0x7F;
+    const uint8_t v = FADE16((uint8_t)y);
+
+    // corner hashes of the current lattice cell
+    uint8_t lastX = 0;
+    uint8_t hAA = 0, hAB = 0, hBA = 0, hBB = 0;
+
+    uint16_t xi = x;
+    for (uint16_t i = 0; i < width; ++i, xi += xScale, ++data)
+    {
+      const uint8_t X = xi >> 8;
+      if (i == 0 or X != lastX)
+      {
+        lastX = X;
+        const uint8_t A = P(X) + Y;
+        const uint8_t B = P(X + 1) + Y;
+        hAA = P(P(A));
+        hAB = P(P(A + 1));
+        hBA = P(P(B));
+        hBB = P(P(B + 1));
+      }
+
+      const int8_t xx = ((uint8_t)(xi) >> 1) & 0x7F;
+      const uint8_t u = FADE16((uint8_t)xi);
+
+      const int8_t X1 = lerp7by8(grad8(hAA, xx, yy), grad8(hBA, xx - N, yy), u);
+      const int8_t X2 = lerp7by8(grad8(hAB, xx, yy - N), grad8(hBB, xx - N, yy - N), u);
+      write_octave(*data, lerp7by8(X1, X2, v), octave);
+    }
+  }
+}
+
+static void fill_noise_3d_octave(uint8_t* data,
+                                 const uint16_t width,
+                                 const uint16_t height,
+                                 const uint16_t x,
+                                 const uint16_t xScale,
+                                 uint16_t y,
+                                 const uint16_t yScale,
+                                 const uint16_t z,
+                                 const uint8_t octave)
+{
+  const uint8_t N = 0x80;
+
+  // shared by the whole grid
+  const uint8_t Z = z >> 8;
+  const int8_t zz = ((uint8_t)(z) >> 1) & 0x7F;
+  const uint8_t w = FADE8((uint8_t)z);
+
+  for (uint16_t j = 0; j < height; ++j, y += yScale)
+  {
+    // shared by the whole row
+    const uint8_t Y = y >> 8;
+    const int8_t yy = ((uint8_t)(y) >> 1) & 0x7F;
+    const uint8_t v = FADE8((uint8_t)y);
+
+    // corner hashes of the current lattice cell
+    uint8_t lastX = 0;
+    uint8_t hAA = 0, hAB = 0, hBA = 0, hBB = 0;
+    uint8_t hAA1 = 0, hAB1 = 0, hBA1 = 0, hBB1 = 0;
+
+    uint16_t xi = x;
+    for (uint16_t i = 0; i < width; ++i, xi += xScale, ++data)
+    {
+      const uint8_t X = xi >> 8;
+      if (i == 0 or X != lastX)
+      {
+        lastX = X;
+        const uint8_t A = P(X) + Y;
+        const uint8_t AA = P(A) + Z;
+        const uint8_t AB = P(A + 1) + Z;
+        const uint8_t B = P(X + 1) + Y;
+        const uint8_t BA = P(B) + Z;
+        const uint8_t BB = P(B + 1) + Z;
+        hAA = P(AA);
+        hAB = P(AB);
+        hBA = P(BA);
+        hBB = P(BB);
+        hAA1 = P(AA + 1);
+        hAB1 = P(AB + 1);
+        hBA1 = P(BA + 1);
+        hBB1 = P(BB + 1);
+      }
+
+      const int8_t xx = ((uint8_t)(xi) >> 1) & 0x7F;
+      const uint8_t u = FADE8((uint8_t)xi);
+
+      const int8_t X1 = lerp7by8(grad8(hAA, xx, yy, zz), grad8(hBA, xx - N, yy, zz), u);
+      const int8_t X2 = lerp7by8(grad8(hAB, xx, yy - N, zz), grad8(hBB, xx - N, yy - N, zz), u);
+      const int8_t X3 = lerp7by8(grad8(hAA1, xx, yy, zz - N), grad8(hBA1, xx - N, yy, zz - N), u);
+      const int8_t X4 = lerp7by8(grad8(hAB1, xx, yy - N, zz - N), grad8(hBB1, xx - N, yy - N, zz - N), u);
+
+      const int8_t Y1 = lerp7by8(X1, X2, v);
+      const int8_t Y2 = lerp7by8(X3, X4, v);
+      write_octave(*data, lerp7by8(Y1, Y2, w), octave);
+    }
+  }
+}
+
+void fill_noise_2d(uint8_t* data,
+                   uint16_t width,
+                   uint16_t height,
+                   uint16_t x,
+                   uint16_t xScale,
+                   uint16_t y,
+                   uint16_t yScale,
+                   uint8_t octaves)
+{
+  for (uint8_t o = 0; o < octaves; ++o)
+  {
+    fill_noise_2d_octave(data, width, height, x << o, xScale << o, y << o, yScale << o, o);
+  }
+}
+
+void fill_noise_3d(uint8_t* data,
+                   uint16_t width,
+                   uint16_t height,
+                   uint16_t x,
+                   uint16_t xScale,
+                   uint16_t y,
+                   uint16_t yScale,
+                   uint16_t z,
+                   uint8_t octaves)
+{
+  for (uint8_t o = 0; o < octaves; ++o)
+  {
+    fill_noise_3d_octave(data, width, height, x << o, xScale << o, y << o, yScale << o, z, o);
+  }
+}
+
 } // namespace noise8
 
 namespace noise16 {
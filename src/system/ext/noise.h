@@ -17,6 +17,38 @@ extern uint8_t inoise(uint16_t x, uint16_t y, uint16_t z);
 // 1d perlin noise with octaves
 extern uint8_t inoise_octaves(uint16_t x, uint8_t octaves, int scale, uint16_t time);
 
+/**
+ * \brief Fill a row-major width x height grid with 2D perlin noise
+ *
+ * data[j * width + i] = inoise(x + i * xScale, y + j * yScale), computed
+ * by walking the lattice cells once per row instead of hashing each pixel.
+ * Each extra octave doubles the coordinates and adds half the amplitude.
+ */
+extern void fill_noise_2d(uint8_t* data,
+                          uint16_t width,
+                          uint16_t height,
+                          uint16_t x,
+                          uint16_t xScale,
+                          uint16_t y,
+                          uint16_t yScale,
+                          uint8_t octaves = 1);
+
+/**
+ * \brief Fill a row-major width x height grid with 3D perlin noise
+ *
+ * data[j * width + i] = inoise(x + i * xScale, y + j * yScale, z), see
+ * fill_noise_2d. The z coordinate (usually time) is not scaled by octaves.
+ */
+extern void fill_noise_3d(uint8_t* data,
+                          uint16_t width,
+                          uint16_t height,
+                          uint16_t x,
+                          uint16_t xScale,
+                          uint16_t y,
+                          uint16_t yScale,
+                          uint16_t z,
+                          uint8_t octaves = 1);
+
 } // namespace noise8
 
 namespace noise16 {
@@ -14,6 +14,7 @@
 #include "src/system/power/charger.h"
 #include "src/system/power/power_handler.h"
 
+#include "src/system/utils/profiler.h"
 #include "src/system/utils/serial.h"
 #include "src/system/utils/utils.h"
 
@@ -223,17 +224,28 @@ void main_loop(const uint32_t addedDelay)
    * Normal loop starts here (all computations)
    */
 
+  const profiler::ScopedTimer loopTimer(profiler::Stage::mainLoop);
+
   // update watchdog (prevent crash)
   kick_watchdog(USER_WATCHDOG_ID);
 
   // loop is not ran in shutdown mode
-  button::handle_events(behavior::button_clicked_callback, behavior::button_hold_callback);
+  {
+    const profiler::ScopedTimer timer(profiler::Stage::button);
+    button::handle_events(behavior::button_clicked_callback, behavior::button_hold_callback);
+  }
 
   // handle user serial events
-  serial::handleSerialEvents();
+  {
+    const profiler::ScopedTimer timer(profiler::Stage::serial);
+    serial::handleSerialEvents();
+  }
 
   // loop the behavior
-  behavior::loop();
+  {
+    const profiler::ScopedTimer timer(profiler::Stage::behavior);
+    behavior::loop();
+  }
 
   // automatically deactivate sensors if they are not used for a time
   microphone::disable_after_non_use();
@@ -502,6 +502,36 @@ float LSM6DS3::calcAccel(int16_t input)
   return output;
 }
 
+//****************************************************************************//
+//
+//  Accelerometer & gyroscope section
+//
+//****************************************************************************//
+status_t LSM6DS3::readRawMotion(int16_t* accel, int16_t* gyro)
+{
+  // axis are stored as consecutive little endian int16 registers
+  uint8_t accelBuffer[6] = {};
+  uint8_t gyroBuffer[6] = {};
+  const i2c_operation operations[2] = {
+          {LSM6DS3_ACC_GYRO_OUTX_L_XL, 0, sizeof(accelBuffer), accelBuffer},
+          {LSM6DS3_ACC_GYRO_OUTX_L_G, 0, sizeof(gyroBuffer), gyroBuffer},
+  };
+
+  status_t returnError = IMU_SUCCESS;
+  if (i2c_transfer(i2cDeviceIndex, I2CAddress, operations, 2, usesStopBit ? 1 : 0) != 0)
+  {
+    returnError = IMU_HW_ERROR;
+    nonSuccessCounter++;
+  }
+
+  for (uint8_t i = 0; i < 3; ++i)
+  {
+    accel[i] = (int16_t)accelBuffer[2 * i] | int16_t(accelBuffer[2 * i + 1] << 8);
+    gyro[i] = (int16_t)gyroBuffer[2 * i] | int16_t(gyroBuffer[2 * i + 1] << 8);
+  }
+  return returnError;
+}
+
 //****************************************************************************//
 //
 //  Gyroscope section
@@ -83,7 +83,7 @@ public:
   // Change to base page
   status_t basePage(void);
 
-private:
+protected:
   // Communication stuff
   uint8_t I2CAddress;
 };
@@ -157,6 +157,9 @@ public:
   int16_t readRawGyroY(void);
   int16_t readRawGyroZ(void);
 
+  // Reads the accelerometer & gyroscope axis (x, y, z) in a single i2c batch
+  status_t readRawMotion(int16_t* accel, int16_t* gyro);
+
   // Returns the values as floats.  Inside, this calls readRaw___();
   float readFloatAccelX(void);
   float readFloatAccelY(void);
@@ -51,15 +51,20 @@ bool Wrapper::shutdown()
 
 Reading Wrapper::get_reading()
 {
+  // all axis in one i2c batch
+  int16_t accel[3];
+  int16_t gyro[3];
+  __internal::IMU.readRawMotion(accel, gyro);
+
   Reading reads;
   // coordinate change to the lamp body
-  reads.accel.x = __internal::IMU.readFloatAccelX();
-  reads.accel.y = __internal::IMU.readFloatAccelY();
-  reads.accel.z = __internal::IMU.readFloatAccelZ();
+  reads.accel.x = __internal::IMU.calcAccel(accel[0]);
+  reads.accel.y = __internal::IMU.calcAccel(accel[1]);
+  reads.accel.z = __internal::IMU.calcAccel(accel[2]);
 
-  reads.gyro.x = __internal::IMU.readFloatGyroX();
-  reads.gyro.y = __internal::IMU.readFloatGyroY();
-  reads.gyro.z = __internal::IMU.readFloatGyroZ();
+  reads.gyro.x = __internal::IMU.calcGyro(gyro[0]);
+  reads.gyro.y = __internal::IMU.calcGyro(gyro[1]);
+  reads.gyro.z = __internal::IMU.calcGyro(gyro[2]);
   return reads;
 }
 
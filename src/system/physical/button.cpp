@@ -75,8 +75,8 @@ void init(const bool isSystemStartedFromButton)
   }
 }
 
-void handle_events(const std::function<void(uint8_t)>& clickSerieCallback,
-                   const std::function<void(uint8_t, uint32_t)>& clickHoldSerieCallback)
+void handle_events(const FunctionRef<void(uint8_t)> clickSerieCallback,
+                   const FunctionRef<void(uint8_t, uint32_t)> clickHoldSerieCallback)
 {
   const bool isButtonPressDetected = wasButtonPressedDetected;
   const uint32_t currentTime = time_ms();
@@ -2,7 +2,8 @@
 #define BUTTON_H
 
 #include <cstdint>
-#include <functional>
+
+#include "src/system/utils/function_ref.h"
 
 namespace button {
 
@@ -19,8 +20,8 @@ void init(const bool isSystemStartedFromButton);
  * the time of the old event (in milliseconds). Called at until the button is
  * released
  */
-void handle_events(const std::function<void(uint8_t)>& clickSerieCallback,
-                   const std::function<void(uint8_t, uint32_t)>& clickHoldSerieCallback);
+void handle_events(const FunctionRef<void(uint8_t)> clickSerieCallback,
+                   const FunctionRef<void(uint8_t, uint32_t)> clickHoldSerieCallback);
 
 /**
  * \brief Indicates that this click is the one triggered by the system start
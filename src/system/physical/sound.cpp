@@ -1,6 +1,7 @@
 #include "sound.h"
 
 #include <cstdint>
+#include <cmath>
 
 #include "src/system/utils/utils.h"
 
@@ -44,25 +45,76 @@ void disable_after_non_use()
   }
 }
 
-float get_sound_level_Db(const PdmData& data)
+// number of blocks in the sound level window (1: level of the latest block)
+static constexpr uint8_t levelWindowBlocks = 1;
+static_assert(levelWindowBlocks <= PdmRing::readableCount, "the window blocks must be readable");
+
+// 10 * log10(1 + i / 32), to interpolate the decibels of a mantissa in [1, 2]
+static constexpr float mantissaDb[33] = {
+        0.0000f, 0.1336f, 0.2633f, 0.3892f, 0.5115f, 0.6305f, 0.7463f, 0.8591f, 0.9691f, 1.0763f, 1.1810f,
+        1.2832f, 1.3830f, 1.4806f, 1.5761f, 1.6695f, 1.7609f, 1.8505f, 1.9382f, 2.0242f, 2.1085f, 2.1913f,
+        2.2724f, 2.3521f, 2.4304f, 2.5072f, 2.5828f, 2.6570f, 2.7300f, 2.8018f, 2.8724f, 2.9419f, 3.0103f};
+
+/**
+ * \brief 10 * log10(value / 2^fractionalBits), from the exponent & a table
+ */
+static float to_decibels(const uint64_t value, const uint8_t fractionalBits)
 {
-  static float lastValue = 0;
+  if (value == 0)
+    return -INFINITY;
 
-  if (!data.is_valid())
-    return lastValue;
+  // value = 2^exponent * (1 + mantissa / 2^16)
+  const uint8_t exponent = 63 - __builtin_clzll(value);
+  const uint32_t mantissa =
+          (exponent >= 16 ? (value >> (exponent - 16)) : (value << (16 - exponent))) & 0xFFFF;
+
+  // 32 table segments, linear interpolation on the 11 lower bits
+  const uint8_t index = mantissa >> 11;
+  const float position = (mantissa & 0x7FF) / 2048.0f;
+  const float mantissaLevel = mantissaDb[index] + (mantissaDb[index + 1] - mantissaDb[index]) * position;
 
-  float sumOfAll = 0.0;
-  const uint16_t samples = min(PdmData::SAMPLE_SIZE, data.sampleRead);
-  for (uint16_t i = 0; i < samples; i++)
+  // 10 * log10(2) = 3.0103
+  return (static_cast<int16_t>(exponent) - fractionalBits) * 3.0103f + mantissaLevel;
+}
+
+// sum of squares over the last blocks, updated by block
+struct LevelWindow
+{
+  uint64_t sums[levelWindowBlocks] = {};
+  uint32_t counts[levelWindowBlocks] = {};
+  uint64_t totalSum = 0;
+  uint32_t totalCount = 0;
+  uint32_t lastSequence = 0;
+
+  // add the blocks published since the last update, return false if none
+  bool update()
   {
-    sumOfAll += powf(data.data[i] / (float)1024.0, 2.0);
+    const uint32_t latest = _private::get().sequence;
+    if (latest == lastSequence)
+      return false;
+
+    // only the last levelWindowBlocks blocks are kept
+    uint32_t sequence = lastSequence + 1;
+    if (latest - lastSequence > levelWindowBlocks)
+      sequence = latest - levelWindowBlocks + 1;
+
+    for (; sequence <= latest; ++sequence)
+    {
+      const PdmData* block = _private::get(sequence);
+      const uint8_t slot = sequence % levelWindowBlocks;
+      totalSum -= sums[slot];
+      totalCount -= counts[slot];
+      sums[slot] = block ? block->sumOfSquares : 0;
+      counts[slot] = block ? block->sampleRead : 0;
+      totalSum += sums[slot];
+      totalCount += counts[slot];
+    }
+    lastSequence = latest;
+    return true;
   }
-  const float average = sumOfAll / (float)samples;
+};
 
-  lastValue = 20.0 * log10f(sqrtf(average));
-  // convert to decibels
-  return lastValue;
-}
+static LevelWindow levelWindow;
 
 float get_sound_level_Db()
 {
@@ -71,17 +123,40 @@ float get_sound_level_Db()
     // ERROR
     return 0.0;
   }
-  return get_sound_level_Db(_private::get());
+
+  static float lastValue = 0;
+
+  // no new samples since the last computation
+  if (not levelWindow.update() or levelWindow.totalCount == 0)
+    return lastValue;
+
+  // 20 * log10(rms / 1024) = 10 * log10(mean of squares) - 10 * log10(1024^2)
+  static constexpr uint8_t fractionalBits = 8;
+  const uint64_t meanOfSquares = (levelWindow.totalSum << fractionalBits) / levelWindow.totalCount;
+  lastValue = to_decibels(meanOfSquares, fractionalBits) - 60.206f;
+  return lastValue;
 }
 
-SoundStruct get_fft()
+const SoundStruct& get_fft()
 {
+  static const SoundStruct invalidSound {};
+  // result of the last transform, and the sequence of its samples
+  static const SoundStruct* lastSound = &invalidSound;
+  static uint32_t lastSequence = 0;
+
   if (!enable())
   {
     // ERROR
-    return SoundStruct();
+    return invalidSound;
+  }
+
+  const PdmData& data = _private::get();
+  if (data.sequence != lastSequence)
+  {
+    lastSequence = data.sequence;
+    lastSound = &_private::process_fft(data);
   }
-  return _private::process_fft(_private::get());
+  return *lastSound;
 }
 
 } // namespace microphone
\ No newline at end of file
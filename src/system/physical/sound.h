@@ -23,9 +23,10 @@ float get_sound_level_Db();
 
 /**
  * \brief compute the fast fourrier transform of the most recent sound sample
- * \return The frequency analysis object
+ * The transform only runs when new samples were read since the last call.
+ * \return The frequency analysis object, valid until the next call
  */
-SoundStruct get_fft();
+const SoundStruct& get_fft();
 
 } // namespace microphone
 
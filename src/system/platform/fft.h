@@ -26,9 +26,12 @@
 #include <array>
 #include <cmath>
 
+#ifndef LMBD_SIMULATION
 #include "arduinoFFT.h"
+#endif
 
 #include "src/system/utils/utils.h"
+#include "src/system/platform/fft_fixed.h"
 
 constexpr int SAMPLE_RATE = 16000; // Base sample rate in Hz - standard.
                                    // Physical sample time -> 50ms
@@ -37,11 +40,63 @@ constexpr int SAMPLE_RATE = 16000; // Base sample rate in Hz - standard.
 // SAMPLE_RATE = 22050;            // Base sample rate in Hz - 22Khz is a
 // standard rate. Physical sample time -> 23ms
 
+#ifndef LMBD_SIMULATION
+/**
+ * \brief Complex float FFT from the arduinoFFT library (imaginary parts are 0)
+ */
+template<uint16_t samples, uint16_t sampleRate> class FloatFftBackend
+{
+public:
+  // input filters need float samples
+  static constexpr bool hasFloatInput = true;
+
+  void set_sample(const uint16_t index, const int16_t value) { vReal[index] = value; }
+
+  float* get_input() { return vReal; }
+
+  // remove DC, apply window, compute the spectrum magnitudes
+  void compute()
+  {
+    for (uint16_t i = 0; i < samples; i++)
+    {
+      vImag[i] = 0;
+    }
+
+    FFT.dcRemoval(); // remove DC offset
+    // FFT.windowing(FFTWindow::Flat_top, FFTDirection::Forward);  // Weigh data
+    // using "Flat Top" window - better amplitude accuracy
+    FFT.windowing(FFTWindow::Blackman_Harris,
+                  FFTDirection::Forward); // Weigh data using "Blackman-
+                                          // Harris" window - sharp peaks due
+                                          // to excellent sideband rejection
+    FFT.compute(FFTDirection::Forward);   // Compute FFT
+    FFT.complexToMagnitude();             // Compute magnitudes
+  }
+
+  float get_magnitude(const uint16_t bin) const { return fabsf(vReal[bin]); }
+
+  void major_peak(float* frequency, float* magnitude) { FFT.majorPeak(frequency, magnitude); }
+
+private:
+  float windowWeighingFactors[samples];
+  float vReal[samples];
+  float vImag[samples];
+
+  // using latest ArduinoFFT lib, because it supports float and its much faster!
+  // lib_deps += https://github.com/kosme/arduinoFFT#develop @ 1.9.2
+  ArduinoFFT<float> FFT = ArduinoFFT<float>(vReal, vImag, samples, sampleRate, windowWeighingFactors);
+};
+#endif
+
 /**
  * samplesFFT Is the input frequency bins before analysis
  * fftResCount Is the resulting frequency bins after analysis
+ * FftBackend Is the transform implementation (FixedFftBackend or FloatFftBackend)
  */
-template<uint16_t samplesFFT, uint16_t fftResCount> class FftAnalyzer
+template<uint16_t samplesFFT,
+         uint16_t fftResCount,
+         template<uint16_t, uint16_t> class FftBackend = FixedFftBackend>
+class FftAnalyzer
 {
 private:
   static constexpr unsigned useInputFilter = 0; // if >0 , enables a bandpass filter 80Hz-8Khz
@@ -70,9 +125,7 @@ private:
   float FFT_MajorPeak = 1.0f;
   float FFT_Magnitude = 0.0001;
 
-  // These are the input and output vectors.  Input vectors receive computed
-  // results from FFT.
-  float windowWeighingFactors[samplesFFT];
+  // Output vector, magnitudes computed by the FFT
   std::array<float, samplesFFT> fftBin;
 
   // valid indexes in the fft bins
@@ -246,12 +299,7 @@ private:
   }
 
   // entry point of the program (TODO: protect it ?)
-  float vReal[samplesFFT];
-  float vImag[samplesFFT];
-
-  // using latest ArduinoFFT lib, because it supports float and its much faster!
-  // lib_deps += https://github.com/kosme/arduinoFFT#develop @ 1.9.2
-  ArduinoFFT<float> FFT = ArduinoFFT<float>(vReal, vImag, samplesFFT, SAMPLE_RATE, windowWeighingFactors);
+  FftBackend<samplesFFT, SAMPLE_RATE> backend;
 
 public:
   void reset()
@@ -307,16 +355,18 @@ public:
   void set_data(const int16_t data, uint16_t index)
   {
     index = lmpd_constrain(index, 0, samplesFFT);
-    vReal[index] = data;
-    vImag[index] = 0;
+    backend.set_sample(index, data);
   }
 
   // FFT main code
   void FFTcode()
   {
     // input filters applied before FFT
-    if (useInputFilter > 0)
+    if constexpr (useInputFilter > 0)
     {
+      static_assert(FftBackend<samplesFFT, SAMPLE_RATE>::hasFloatInput, "input filters need a float FFT backend");
+      float* vReal = backend.get_input();
+
       // filter parameter - we use constexpr as it does not need any RAM
       // (evaluted at compile time) value = 1 - exp(-2*c_PI * FFilter / FSample);
       // // FFilter: filter cutoff frequency; FSample: sampling frequency
@@ -354,49 +404,15 @@ public:
       }
     }
 
-    // find highest sample in the batch
-    const int halfSamplesFFT = samplesFFT / 2; // samplesFFT divided by 2
-    float maxSample1 = 0.0;                    // max sample from first half of FFT batch
-    float maxSample2 = 0.0;                    // max sample from second half of FFT batch
-    for (int i = 0; i < samplesFFT; i++)
-    {
-      // set imaginary parts to 0
-      vImag[i] = 0;
-      // pick our  our current mic sample - we take the max value from all
-      // samples that go into FFT
-      if ((vReal[i] <= (INT16_MAX - 1024)) &&
-          (vReal[i] >= (INT16_MIN + 1024))) // skip extreme values - normally these are artefacts
-      {
-        if (i <= halfSamplesFFT)
-        {
-          if (fabsf(vReal[i]) > maxSample1)
-            maxSample1 = fabsf(vReal[i]);
-        }
-        else
-        {
-          if (fabsf(vReal[i]) > maxSample2)
-            maxSample2 = fabsf(vReal[i]);
-        }
-      }
-    }
-
-    FFT.dcRemoval(); // remove DC offset
-    // FFT.windowing(FFTWindow::Flat_top, FFTDirection::Forward);  // Weigh data
-    // using "Flat Top" window - better amplitude accuracy
-    FFT.windowing(FFTWindow::Blackman_Harris,
-                  FFTDirection::Forward); // Weigh data using "Blackman-
-                                          // Harris" window - sharp peaks due
-                                          // to excellent sideband rejection
-    FFT.compute(FFTDirection::Forward);   // Compute FFT
-    FFT.complexToMagnitude();             // Compute magnitudes
+    backend.compute(); // remove DC, apply window & compute magnitudes
     //
-    // vReal[3 .. 255] contain useful data, each a 20Hz interval (60Hz -
+    // magnitudes[3 .. 255] contain useful data, each a 20Hz interval (60Hz -
     // 5120Hz). There could be interesting data at bins 0 to 2, but there are
     // too many artifacts.
     //
 
-    FFT.majorPeak(&FFT_MajorPeak,
-                  &FFT_Magnitude); // let the effects know which freq was most dominant
+    backend.major_peak(&FFT_MajorPeak,
+                       &FFT_Magnitude); // let the effects know which freq was most dominant
     FFT_MajorPeak = lmpd_constrain(FFT_MajorPeak, 1.0f,
                                    5120.0f); // restrict value to range expected by effects
     FFT_Magnitude = fabsf(FFT_Magnitude);
@@ -405,8 +421,7 @@ public:
     { // Values for bins 0 and 1 are WAY too
       // large. Might as well start at 3.
       float t = 0.0;
-      t = fabsf(vReal[i]); // just to be sure - values in fft bins should be
-                           // positive any way
+      t = backend.get_magnitude(i); // values in fft bins are positive
       t = t / 16.0f;       // Reduce magnitude. Want end result to be linear and
                            // ~4096 max.
       fftBin[i] = t;
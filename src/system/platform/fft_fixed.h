@@ -0,0 +1,269 @@
+#ifndef PLATFORM_FFT_FIXED_H
+#define PLATFORM_FFT_FIXED_H
+
+#include <cstdint>
+#include <cmath>
+
+/// Precomputed window & twiddle tables of FixedFftBackend, kept in flash
+namespace fftFixedTables {
+
+// size of the transform the tables are computed for
+static constexpr uint16_t tableSamples = 512;
+
+// half of the symmetric Blackman-Harris window in Q15, computed as arduinoFFT does:
+// r = i / (samples - 1), lround((0.35875 - 0.48829.cos(2.pi.r) + 0.14128.cos(4.pi.r) - 0.01168.cos(6.pi.r)) * 32767)
+inline constexpr int16_t window[tableSamples / 2] = {
+        2, 2, 2, 3, 3, 4, 5, 5, 7, 8, 9, 11, 13, 15, 17, 19, 22, 24, 27, 31, 34, 38, 42, 46, 51, 56, 61, 67, 73, 79, 86,
+        93, 101, 109, 117, 126, 136, 146, 157, 168, 180, 192, 206, 219, 234, 249, 265, 282, 300, 318, 338, 358, 379,
+        401, 424, 448, 474, 500, 527, 556, 585, 616, 648, 682, 717, 753, 790, 829, 869, 911, 955, 1000, 1046, 1094,
+        1144, 1195, 1249, 1304, 1360, 1419, 1480, 1542, 1606, 1673, 1741, 1811, 1884, 1958, 2035, 2114, 2195, 2279,
+        2364, 2452, 2543, 2635, 2730, 2828, 2928, 3030, 3135, 3243, 3353, 3466, 3581, 3699, 3819, 3943, 4069, 4197,
+        4329, 4463, 4600, 4739, 4882, 5027, 5175, 5326, 5479, 5636, 5795, 5957, 6122, 6290, 6461, 6634, 6811, 6990,
+        7172, 7356, 7544, 7734, 7927, 8123, 8321, 8522, 8726, 8933, 9142, 9354, 9568, 9785, 10004, 10226, 10450, 10677,
+        10906, 11137, 11371, 11607, 11845, 12085, 12327, 12571, 12817, 13065, 13315, 13566, 13820, 14075, 14331, 14589,
+        14849, 15110, 15372, 15635, 15900, 16166, 16432, 16700, 16968, 17237, 17507, 17777, 18048, 18319, 18591, 18862,
+        19134, 19406, 19678, 19949, 20220, 20491, 20762, 21032, 21301, 21569, 21837, 22104, 22369, 22634, 22897, 23158,
+        23419, 23677, 23934, 24189, 24443, 24694, 24943, 25190, 25435, 25677, 25916, 26153, 26388, 26619, 26848, 27073,
+        27296, 27515, 27731, 27944, 28153, 28358, 28560, 28758, 28952, 29142, 29328, 29510, 29688, 29861, 30030, 30195,
+        30355, 30511, 30662, 30808, 30949, 31085, 31217, 31343, 31465, 31581, 31692, 31798, 31899, 31994, 32084, 32169,
+        32248, 32321, 32389, 32452, 32509, 32560, 32606, 32646, 32680, 32709, 32732, 32749, 32761, 32766};
+
+// lround(cos(2.pi.i / samples) * 32767)
+inline constexpr int16_t cosTable[tableSamples] = {
+        32767, 32765, 32757, 32745, 32728, 32705, 32678, 32646, 32609, 32567, 32521, 32469, 32412, 32351, 32285, 32213,
+        32137, 32057, 31971, 31880, 31785, 31685, 31580, 31470, 31356, 31237, 31113, 30985, 30852, 30714, 30571, 30424,
+        30273, 30117, 29956, 29791, 29621, 29447, 29268, 29085, 28898, 28706, 28510, 28310, 28105, 27896, 27683, 27466,
+        27245, 27019, 26790, 26556, 26319, 26077, 25832, 25582, 25329, 25072, 24811, 24547, 24279, 24007, 23731, 23452,
+        23170, 22884, 22594, 22301, 22005, 21705, 21403, 21096, 20787, 20475, 20159, 19841, 19519, 19195, 18868, 18537,
+        18204, 17869, 17530, 17189, 16846, 16499, 16151, 15800, 15446, 15090, 14732, 14372, 14010, 13645, 13279, 12910,
+        12539, 12167, 11793, 11417, 11039, 10659, 10278, 9896, 9512, 9126, 8739, 8351, 7962, 7571, 7179, 6786, 6393,
+        5998, 5602, 5205, 4808, 4410, 4011, 3612, 3212, 2811, 2410, 2009, 1608, 1206, 804, 402, 0, -402, -804, -1206,
+        -1608, -2009, -2410, -2811, -3212, -3612, -4011, -4410, -4808, -5205, -5602, -5998, -6393, -6786, -7179, -7571,
+        -7962, -8351, -8739, -9126, -9512, -9896, -10278, -10659, -11039, -11417, -11793, -12167, -12539, -12910,
+        -13279, -13645, -14010, -14372, -14732, -15090, -15446, -15800, -16151, -16499, -16846, -17189, -17530, -17869,
+        -18204, -18537, -18868, -19195, -19519, -19841, -20159, -20475, -20787, -21096, -21403, -21705, -22005, -22301,
+        -22594, -22884, -23170, -23452, -23731, -24007, -24279, -24547, -24811, -25072, -25329, -25582, -25832, -26077,
+        -26319, -26556, -26790, -27019, -27245, -27466, -27683, -27896, -28105, -28310, -28510, -28706, -28898, -29085,
+        -29268, -29447, -29621, -29791, -29956, -30117, -30273, -30424, -30571, -30714, -30852, -30985, -31113, -31237,
+        -31356, -31470, -31580, -31685, -31785, -31880, -31971, -32057, -32137, -32213, -32285, -32351, -32412, -32469,
+        -32521, -32567, -32609, -32646, -32678, -32705, -32728, -32745, -32757, -32765, -32767, -32765, -32757, -32745,
+        -32728, -32705, -32678, -32646, -32609, -32567, -32521, -32469, -32412, -32351, -32285, -32213, -32137, -32057,
+        -31971, -31880, -31785, -31685, -31580, -31470, -31356, -31237, -31113, -30985, -30852, -30714, -30571, -30424,
+        -30273, -30117, -29956, -29791, -29621, -29447, -29268, -29085, -28898, -28706, -28510, -28310, -28105, -27896,
+        -27683, -27466, -27245, -27019, -26790, -26556, -26319, -26077, -25832, -25582, -25329, -25072, -24811, -24547,
+        -24279, -24007, -23731, -23452, -23170, -22884, -22594, -22301, -22005, -21705, -21403, -21096, -20787, -20475,
+        -20159, -19841, -19519, -19195, -18868, -18537, -18204, -17869, -17530, -17189, -16846, -16499, -16151, -15800,
+        -15446, -15090, -14732, -14372, -14010, -13645, -13279, -12910, -12539, -12167, -11793, -11417, -11039, -10659,
+        -10278, -9896, -9512, -9126, -8739, -8351, -7962, -7571, -7179, -6786, -6393, -5998, -5602, -5205, -4808, -4410,
+        -4011, -3612, -3212, -2811, -2410, -2009, -1608, -1206, -804, -402, 0, 402, 804, 1206, 1608, 2009, 2410, 2811,
+        3212, 3612, 4011, 4410, 4808, 5205, 5602, 5998, 6393, 6786, 7179, 7571, 7962, 8351, 8739, 9126, 9512, 9896,
+        10278, 10659, 11039, 11417, 11793, 12167, 12539, 12910, 13279, 13645, 14010, 14372, 14732, 15090, 15446, 15800,
+        16151, 16499, 16846, 17189, 17530, 17869, 18204, 18537, 18868, 19195, 19519, 19841, 20159, 20475, 20787, 21096,
+        21403, 21705, 22005, 22301, 22594, 22884, 23170, 23452, 23731, 24007, 24279, 24547, 24811, 25072, 25329, 25582,
+        25832, 26077, 26319, 26556, 26790, 27019, 27245, 27466, 27683, 27896, 28105, 28310, 28510, 28706, 28898, 29085,
+        29268, 29447, 29621, 29791, 29956, 30117, 30273, 30424, 30571, 30714, 30852, 30985, 31113, 31237, 31356, 31470,
+        31580, 31685, 31785, 31880, 31971, 32057, 32137, 32213, 32285, 32351, 32412, 32469, 32521, 32567, 32609, 32646,
+        32678, 32705, 32728, 32745, 32757, 32765};
+
+} // namespace fftFixedTables
+
+/**
+ * \brief Fixed-point FFT of real samples, for the FftAnalyzer
+ *
+ * The real samples are packed as samples/2 complex values, transformed by a
+ * radix-4 FFT on Q31 data with Q15 twiddles, then split in the samples/2 + 1
+ * bins of the real spectrum. Each radix-4 stage scales its inputs by 1/4, so
+ * the transform can not overflow.
+ *
+ * The DC offset is removed and a Blackman-Harris window applied before the
+ * transform (same as the float backend), the window and twiddle tables are
+ * precomputed constants (see fftFixedTables).
+ *
+ * Magnitudes are scaled back to the units of an unnormalized transform.
+ */
+template<uint16_t samples, uint16_t sampleRate> class FixedFftBackend
+{
+public:
+  // input filters need float samples
+  static constexpr bool hasFloatInput = false;
+
+  void set_sample(const uint16_t index, const int16_t value) { input[index] = value; }
+
+  // remove DC, apply window, compute the spectrum magnitudes
+  void compute()
+  {
+    load_windowed_input();
+    transform();
+    split_real_spectrum();
+  }
+
+  // magnitude of a frequency bin (mirrored above samples/2)
+  float get_magnitude(const uint16_t bin) const { return magnitudes[bin <= half ? bin : samples - bin]; }
+
+  // interpolated frequency & magnitude of the highest peak (as arduinoFFT)
+  void major_peak(float* frequency, float* magnitude) const
+  {
+    float maxY = 0;
+    uint16_t indexOfMaxY = 0;
+    // scan up to the Nyquist bin, its right neighbour is mirrored
+    for (uint16_t i = 1; i <= half; i++)
+    {
+      const float here = magnitudes[i];
+      if (magnitudes[i - 1] < here and here > get_magnitude(i + 1) and here > maxY)
+      {
+        maxY = here;
+        indexOfMaxY = i;
+      }
+    }
+
+    const float before = magnitudes[indexOfMaxY > 0 ? indexOfMaxY - 1 : 0];
+    const float here = magnitudes[indexOfMaxY];
+    const float after = get_magnitude(indexOfMaxY + 1);
+    const float curvature = before - (2.0f * here) + after;
+    // flat spectrum (no peak): do not interpolate
+    const float delta = (curvature != 0.0f) ? 0.5f * ((before - after) / curvature) : 0.0f;
+
+    // arduinoFFT divides by samples for the edge bin
+    const uint16_t divider = (indexOfMaxY == half) ? samples : samples - 1;
+    *frequency = ((indexOfMaxY + delta) * sampleRate) / divider;
+    *magnitude = fabsf(curvature);
+  }
+
+private:
+  // size of the complex transform
+  static constexpr uint16_t half = samples / 2;
+
+  static constexpr uint8_t count_stages()
+  {
+    uint8_t stages = 0;
+    for (uint16_t size = 1; size < half; size *= 4)
+      stages++;
+    return stages;
+  }
+  static constexpr uint8_t stageCount = count_stages();
+  static_assert((1u << (2 * stageCount)) == half, "samples must be twice a power of 4");
+
+  // windowed samples are stored in Q31 with one bit of headroom
+  static constexpr uint8_t inputShift = 14;
+  // scaling of the transform (1/half) and of the input, undone on magnitudes
+  static constexpr float outputScale = static_cast<float>(half) / (1 << inputShift);
+
+  struct Complex
+  {
+    int32_t re;
+    int32_t im;
+  };
+
+  int16_t input[samples];
+  Complex buffer[half];
+  float magnitudes[half + 1];
+
+  static_assert(samples == fftFixedTables::tableSamples, "the precomputed tables need to be regenerated");
+
+  // twiddle e^(-2i.pi.index/samples) as cos - i.sin
+  static int32_t twiddle_cos(const uint16_t index) { return fftFixedTables::cosTable[index % samples]; }
+  static int32_t twiddle_sin(const uint16_t index)
+  {
+    return fftFixedTables::cosTable[(index + samples - samples / 4) % samples];
+  }
+
+  // multiply by e^(-2i.pi.index/samples)
+  static Complex rotate(const Complex& value, const uint16_t index)
+  {
+    const int64_t c = twiddle_cos(index);
+    const int64_t s = twiddle_sin(index);
+    return {static_cast<int32_t>((value.re * c + value.im * s) >> 15),
+            static_cast<int32_t>((value.im * c - value.re * s) >> 15)};
+  }
+
+  static uint16_t digit_reverse(uint16_t index)
+  {
+    uint16_t reversed = 0;
+    for (uint8_t stage = 0; stage < stageCount; stage++)
+    {
+      reversed = (reversed << 2) | (index & 3);
+      index >>= 2;
+    }
+    return reversed;
+  }
+
+  // remove DC & window, pack even/odd samples as real/imaginary parts
+  void load_windowed_input()
+  {
+    int32_t sum = 0;
+    for (uint16_t i = 0; i < samples; i++)
+      sum += input[i];
+    const int32_t mean = sum / samples;
+
+    for (uint16_t i = 0; i < samples; i++)
+    {
+      const int32_t weight = fftFixedTables::window[i < half ? i : samples - 1 - i];
+      // (sample * weight) >> 15 << inputShift
+      const int32_t value = ((input[i] - mean) * weight) >> (15 - inputShift);
+
+      Complex& packed = buffer[digit_reverse(i / 2)];
+      if (i % 2 == 0)
+        packed.re = value;
+      else
+        packed.im = value;
+    }
+  }
+
+  // in-place radix-4 decimation in time, on digit-reversed input
+  void transform()
+  {
+    for (uint16_t size = 4; size <= half; size *= 4)
+    {
+      const uint16_t quarter = size / 4;
+      // twiddle step in cosTable, e^(-2i.pi/size) = e^(-2i.pi.(samples/size)/samples)
+      const uint16_t step = samples / size;
+
+      for (uint16_t base = 0; base < half; base += size)
+      {
+        for (uint16_t j = 0; j < quarter; j++)
+        {
+          Complex* x = buffer + base + j;
+          const Complex a0 = {x[0].re >> 2, x[0].im >> 2};
+          const Complex a1 = rotate({x[quarter].re >> 2, x[quarter].im >> 2}, j * step);
+          const Complex a2 = rotate({x[2 * quarter].re >> 2, x[2 * quarter].im >> 2}, 2 * j * step);
+          const Complex a3 = rotate({x[3 * quarter].re >> 2, x[3 * quarter].im >> 2}, 3 * j * step);
+
+          const Complex t0 = {a0.re + a2.re, a0.im + a2.im};
+          const Complex t1 = {a0.re - a2.re, a0.im - a2.im};
+          const Complex t2 = {a1.re + a3.re, a1.im + a3.im};
+          const Complex t3 = {a1.re - a3.re, a1.im - a3.im};
+
+          x[0] = {t0.re + t2.re, t0.im + t2.im};
+          x[quarter] = {t1.re + t3.im, t1.im - t3.re};
+          x[2 * quarter] = {t0.re - t2.re, t0.im - t2.im};
+          x[3 * quarter] = {t1.re - t3.im, t1.im + t3.re};
+        }
+      }
+    }
+  }
+
+  // spectrum of the real samples from the spectrum of the packed samples
+  void split_real_spectrum()
+  {
+    for (uint16_t k = 0; k <= half; k++)
+    {
+      const Complex& z = buffer[k % half];
+      const Complex& mirror = buffer[(half - k) % half];
+
+      // even samples spectrum: (Z[k] + conj(Z[-k])) / 2
+      const int64_t evenRe = (static_cast<int64_t>(z.re) + mirror.re) / 2;
+      const int64_t evenIm = (static_cast<int64_t>(z.im) - mirror.im) / 2;
+      // odd samples spectrum: (Z[k] - conj(Z[-k])) / 2i
+      const int64_t oddRe = (static_cast<int64_t>(z.im) + mirror.im) / 2;
+      const int64_t oddIm = (static_cast<int64_t>(mirror.re) - z.re) / 2;
+
+      const int64_t c = twiddle_cos(k);
+      const int64_t s = twiddle_sin(k);
+      const float re = evenRe + ((oddRe * c + oddIm * s) >> 15);
+      const float im = evenIm + ((oddIm * c - oddRe * s) >> 15);
+      magnitudes[k] = sqrtf(re * re + im * im) * outputScale;
+    }
+  }
+};
+
+#endif
@@ -1,12 +1,14 @@
 #ifndef PLATFORM_GPIO_H
 #define PLATFORM_GPIO_H
 
-#include <set>
-#include <memory>
 #include <stdint.h>
 
-class DigitalPinImpl;
-
+/**
+ * \brief Handle on a programmable pin
+ *
+ * Handles only store the pin id, they are trivially copyable and never
+ * allocate: the platform resolves the physical pin in a static table.
+ */
 class DigitalPin
 {
 public:
@@ -39,7 +41,10 @@ public:
     // danger zone: only one of the next 3 signals should be active at a time
     Output_DischargeVbus,
     Output_EnableVbusGate,
-    Output_EnableOutputGate
+    Output_EnableOutputGate,
+
+    // number of pins, not a pin
+    Count
   };
   enum Mode
   {
@@ -58,12 +63,7 @@ public:
     kFallingEdge,
   };
 
-  DigitalPin(GPIO pin);
-  ~DigitalPin();
-  DigitalPin(const DigitalPin& other);
-  DigitalPin& operator=(const DigitalPin& other);
-
-  DigitalPin(DigitalPin&& other) = delete;
+  constexpr DigitalPin(GPIO pin) : mGpio(pin) {}
 
   void set_pin_mode(Mode mode);
   bool is_high() const; // true if high, false if low
@@ -85,11 +85,14 @@ public:
   static void detach_all()
   {
     // detach all set interrupts
-    for (DigitalPin::GPIO pin: DigitalPin::s_gpiosWithInterrupts)
+    for (int pin = GPIO::gpio0; pin != GPIO::Count; ++pin)
     {
-      DigitalPin(pin).detach_callbacks();
+      if (DigitalPin::s_gpiosWithInterrupts & interrupt_mask((GPIO)pin))
+      {
+        DigitalPin((GPIO)pin).detach_callbacks();
+      }
     }
-    DigitalPin::s_gpiosWithInterrupts.clear();
+    DigitalPin::s_gpiosWithInterrupts = 0;
   }
 
   // call this when the gpios needs to be deactivated
@@ -103,10 +106,13 @@ public:
   }
 
 private:
-  inline static std::set<GPIO> s_gpiosWithInterrupts;
+  static_assert(GPIO::Count <= 32, "s_gpiosWithInterrupts has one bit per pin");
+  static constexpr uint32_t interrupt_mask(GPIO pin) { return 1u << pin; }
+
+  // one bit per pin with an attached interrupt
+  inline static uint32_t s_gpiosWithInterrupts = 0;
 
   GPIO mGpio;
-  std::shared_ptr<DigitalPinImpl> mImpl;
 };
 
 #endif
\ No newline at end of file
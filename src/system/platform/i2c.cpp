@@ -3,23 +3,239 @@
 
 #include "i2c.h"
 
+#include "threads.h"
 #include "time.h"
 
 #include <cassert>
 
 // platform specific code
-#include "Wire.h"
-#include "rtos.h" // tied to FreeRTOS for serialization
+#include "Wire.h" // TWIM peripheral, with EasyDMA transfers
+#include "rtos.h" // tied to FreeRTOS for the worker & queues
 
 // set the two interfaces
 TwoWire* PROGMEM interfaces[] = {&Wire};
 
-// mutex to prevent i2c lockups
-StaticSemaphore_t _Mutex;
-SemaphoreHandle_t i2cMutex = xSemaphoreCreateMutexStatic(&_Mutex);
+namespace {
 
-void _lockMutex(void) { xSemaphoreTake(i2cMutex, portMAX_DELAY); }
-void _unlockMutex(void) { xSemaphoreGive(i2cMutex); }
+// a transfer to service, as described by the caller
+struct Transaction
+{
+  enum Kind : uint8_t
+  {
+    kBatch,
+    kXfer,
+    kCheckExistence
+  };
+  Kind kind;
+  uint8_t i2cIndex;
+  uint8_t deviceAddr;
+
+  // kBatch
+  i2c_operation operations[i2cMaxBatchOperations];
+  uint8_t operationCount;
+  int stopBit;
+
+  // kXfer
+  int outSize;
+  const uint8_t* out;
+  int inSize;
+  uint8_t* in;
+  uint8_t flags;
+
+  // if set, called by the worker, else the caller waits for the result
+  i2c_callback callback;
+  void* userData;
+};
+
+// a transaction in the queue, with its completion
+struct Slot
+{
+  Transaction transaction;
+  int result;
+
+  SemaphoreHandle_t done;
+  StaticSemaphore_t doneBuffer;
+};
+
+// transactions that can be queued at once, callers wait for a free slot past that
+constexpr uint8_t slotCount = 8;
+// the worker runs the callbacks, on its own stack
+constexpr uint32_t workerStackSize = 512;
+
+Slot slots[slotCount];
+
+// indexes of the free slots, and of the slots to service (in order)
+QueueHandle_t freeSlots = nullptr;
+QueueHandle_t pendingSlots = nullptr;
+StaticQueue_t freeSlotsBuffer;
+StaticQueue_t pendingSlotsBuffer;
+uint8_t freeSlotsStorage[slotCount];
+uint8_t pendingSlotsStorage[slotCount];
+
+// only task using the interfaces, once started
+TaskHandle_t worker = nullptr;
+StaticTask_t workerBuffer;
+StackType_t workerStack[workerStackSize];
+
+int run_operation(TwoWire* wire, const uint8_t deviceAddr, const i2c_operation& operation, const int stopBit)
+{
+  wire->beginTransmission(deviceAddr);
+  wire->write(operation.registerAdd);
+  if (operation.isWrite)
+  {
+    wire->write(operation.buf, operation.size);
+    wire->endTransmission(stopBit != 0);
+    return 0;
+  }
+  wire->endTransmission(stopBit != 0);
+
+  wire->requestFrom(deviceAddr, operation.size);
+  uint8_t* buf = operation.buf;
+  uint8_t count = operation.size;
+  while (wire->available() && count > 0)
+  {
+    *buf++ = wire->read();
+    count--;
+  }
+  // return 0 for success
+  return (count == 0) ? 0 : 1;
+}
+
+int run_xfer(TwoWire* wire, const Transaction& transaction)
+{
+  if (transaction.outSize)
+  {
+    wire->beginTransmission(transaction.deviceAddr);
+    wire->write(transaction.out, transaction.outSize);
+    wire->endTransmission((transaction.flags & I2C_XFER_STOP) != 0);
+  }
+
+  if (transaction.inSize)
+  {
+    wire->requestFrom(transaction.deviceAddr, transaction.inSize, (transaction.flags & I2C_XFER_STOP));
+    uint8_t* in = transaction.in;
+    for (int inSize = transaction.inSize; inSize > 0; inSize--)
+    {
+      *in++ = wire->read();
+    }
+  }
+  return 0;
+}
+
+// access the bus, only from the worker (or before it starts)
+int run_transaction(const Transaction& transaction)
+{
+  auto wire = interfaces[transaction.i2cIndex];
+  switch (transaction.kind)
+  {
+    case Transaction::kBatch:
+      {
+        int result = 0;
+        for (uint8_t i = 0; i < transaction.operationCount; ++i)
+        {
+          result |= run_operation(wire, transaction.deviceAddr, transaction.operations[i], transaction.stopBit);
+        }
+        return result;
+      }
+    case Transaction::kXfer:
+      return run_xfer(wire, transaction);
+    case Transaction::kCheckExistence:
+      wire->beginTransmission(transaction.deviceAddr);
+      return wire->endTransmission();
+  }
+  return 1;
+}
+
+void worker_task(void*)
+{
+  while (true)
+  {
+    uint8_t index;
+    if (xQueueReceive(pendingSlots, &index, portMAX_DELAY) != pdTRUE)
+      continue;
+
+    Slot& slot = slots[index];
+    slot.result = run_transaction(slot.transaction);
+
+    if (slot.transaction.callback != nullptr)
+    {
+      slot.transaction.callback(slot.result, slot.transaction.userData);
+      xQueueSend(freeSlots, &index, 0);
+    }
+    else
+    {
+      // the waiting caller frees the slot
+      xSemaphoreGive(slot.done);
+    }
+  }
+}
+
+void start_worker()
+{
+  if (worker != nullptr)
+    return;
+
+  freeSlots = xQueueCreateStatic(slotCount, sizeof(uint8_t), freeSlotsStorage, &freeSlotsBuffer);
+  pendingSlots = xQueueCreateStatic(slotCount, sizeof(uint8_t), pendingSlotsStorage, &pendingSlotsBuffer);
+  for (uint8_t i = 0; i < slotCount; ++i)
+  {
+    slots[i].done = xSemaphoreCreateBinaryStatic(&slots[i].doneBuffer);
+    xQueueSend(freeSlots, &i, 0);
+  }
+
+  // created outside of the threads.h pool: suspend_all_threads() must not stop
+  // it, the shutdown sequence still talks to the power components
+  worker = xTaskCreateStatic(
+          worker_task, i2c_taskName, workerStackSize, nullptr, TASK_PRIO_NORMAL, workerStack, &workerBuffer);
+}
+
+// run a transaction through the worker, return its result (or 0 once queued for callbacks)
+int execute(const Transaction& transaction)
+{
+  // before setup, or from a worker callback: use the bus directly
+  if (worker == nullptr or xTaskGetCurrentTaskHandle() == worker)
+  {
+    const int result = run_transaction(transaction);
+    if (transaction.callback != nullptr)
+    {
+      transaction.callback(result, transaction.userData);
+      return 0;
+    }
+    return result;
+  }
+
+  uint8_t index;
+  xQueueReceive(freeSlots, &index, portMAX_DELAY);
+  Slot& slot = slots[index];
+  slot.transaction = transaction;
+  xQueueSend(pendingSlots, &index, portMAX_DELAY);
+
+  if (transaction.callback != nullptr)
+    return 0;
+
+  xSemaphoreTake(slot.done, portMAX_DELAY);
+  const int result = slot.result;
+  xQueueSend(freeSlots, &index, 0);
+  return result;
+}
+
+Transaction make_batch(
+        uint8_t i2cIndex, uint8_t deviceAddr, const i2c_operation* operations, uint8_t count, int stopBit)
+{
+  Transaction transaction = {};
+  transaction.kind = Transaction::kBatch;
+  transaction.i2cIndex = i2cIndex;
+  transaction.deviceAddr = deviceAddr;
+  for (uint8_t i = 0; i < count; ++i)
+  {
+    transaction.operations[i] = operations[i];
+  }
+  transaction.operationCount = count;
+  transaction.stopBit = stopBit;
+  return transaction;
+}
+
+} // namespace
 
 void i2c_setup(uint8_t i2cIndex, uint32_t baudrate, uint32_t timeout)
 {
@@ -35,6 +251,8 @@ void i2c_setup(uint8_t i2cIndex, uint32_t baudrate, uint32_t timeout)
   // set parameters
   wire->setClock(baudrate);
   wire->setTimeout(timeout);
+
+  start_worker();
 }
 
 int i2c_check_existence(uint8_t i2cIndex, uint8_t deviceAddr)
@@ -43,61 +261,54 @@ int i2c_check_existence(uint8_t i2cIndex, uint8_t deviceAddr)
   {
     return 1;
   }
-  _lockMutex();
-  auto wire = interfaces[i2cIndex];
-
-  wire->beginTransmission(deviceAddr);
-  const auto res = wire->endTransmission();
 
-  _unlockMutex();
-
-  return res;
+  Transaction transaction = {};
+  transaction.kind = Transaction::kCheckExistence;
+  transaction.i2cIndex = i2cIndex;
+  transaction.deviceAddr = deviceAddr;
+  return execute(transaction);
 }
 
-int i2c_writeData(uint8_t i2cIndex, uint8_t deviceAddr, uint8_t registerAdd, uint8_t size, uint8_t* buf, int stopBit)
+int i2c_transfer(uint8_t i2cIndex, uint8_t deviceAddr, const i2c_operation* operations, uint8_t count, int stopBit)
 {
-  if (i2cIndex >= WIRE_INTERFACES_COUNT)
+  if (i2cIndex >= WIRE_INTERFACES_COUNT or count > i2cMaxBatchOperations)
   {
     assert(false);
     return 1;
   }
-  _lockMutex();
-  auto wire = interfaces[i2cIndex];
-
-  wire->beginTransmission(deviceAddr);
-  wire->write(registerAdd);
-  const uint8_t written = wire->write(buf, size);
-  wire->endTransmission(stopBit != 0);
-
-  _unlockMutex();
-
-  return 0;
+  return execute(make_batch(i2cIndex, deviceAddr, operations, count, stopBit));
 }
 
-int i2c_readData(uint8_t i2cIndex, uint8_t deviceAddr, uint8_t registerAdd, uint8_t size, uint8_t* buf, int stopBit)
+int i2c_submit(uint8_t i2cIndex,
+               uint8_t deviceAddr,
+               const i2c_operation* operations,
+               uint8_t count,
+               int stopBit,
+               i2c_callback callback,
+               void* userData)
 {
-  if (i2cIndex >= WIRE_INTERFACES_COUNT)
+  if (i2cIndex >= WIRE_INTERFACES_COUNT or count > i2cMaxBatchOperations or callback == nullptr)
   {
     assert(false);
     return 1;
   }
-  _lockMutex();
-  auto wire = interfaces[i2cIndex];
 
-  wire->beginTransmission(deviceAddr);
-  wire->write(registerAdd);
-  wire->endTransmission(stopBit != 0);
-  wire->requestFrom(deviceAddr, size);
-  uint8_t count = size;
-  while (wire->available() && count > 0)
-  {
-    *buf++ = wire->read();
-    count--;
-  }
-  _unlockMutex();
+  Transaction transaction = make_batch(i2cIndex, deviceAddr, operations, count, stopBit);
+  transaction.callback = callback;
+  transaction.userData = userData;
+  return execute(transaction);
+}
 
-  // return 0 for success
-  return (count == 0) ? 0 : 1;
+int i2c_writeData(uint8_t i2cIndex, uint8_t deviceAddr, uint8_t registerAdd, uint8_t size, uint8_t* buf, int stopBit)
+{
+  const i2c_operation operation = {registerAdd, 1, size, buf};
+  return i2c_transfer(i2cIndex, deviceAddr, &operation, 1, stopBit);
+}
+
+int i2c_readData(uint8_t i2cIndex, uint8_t deviceAddr, uint8_t registerAdd, uint8_t size, uint8_t* buf, int stopBit)
+{
+  const i2c_operation operation = {registerAdd, 0, size, buf};
+  return i2c_transfer(i2cIndex, deviceAddr, &operation, 1, stopBit);
 }
 
 int i2c_xfer(
@@ -109,32 +320,16 @@ int i2c_xfer(
     return 1;
   }
 
-  _lockMutex();
-  auto wire = interfaces[i2cIndex];
-
-  if (out_size)
-  {
-    wire->beginTransmission(deviceAddr);
-    for (; out_size > 0; out_size--)
-    {
-      wire->write(*out);
-      out++;
-    }
-    wire->endTransmission((flags & I2C_XFER_STOP) != 0);
-  }
-
-  if (in_size)
-  {
-    wire->requestFrom(deviceAddr, in_size, (flags & I2C_XFER_STOP));
-    for (; in_size > 0; in_size--)
-    {
-      *in = wire->read();
-      in++;
-    }
-  }
-  _unlockMutex();
-
-  return 0;
+  Transaction transaction = {};
+  transaction.kind = Transaction::kXfer;
+  transaction.i2cIndex = i2cIndex;
+  transaction.deviceAddr = deviceAddr;
+  transaction.outSize = out_size;
+  transaction.out = out;
+  transaction.inSize = in_size;
+  transaction.in = in;
+  transaction.flags = flags;
+  return execute(transaction);
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -80,6 +80,62 @@ extern "C" {
                       uint8_t* in,
                       uint8_t flags);
 
+  /**
+   * Batched transactions: the transfers are queued and serviced by a single
+   * i2c worker, callers never hold the bus. All the operations of a batch are
+   * done back to back on the same device.
+   */
+
+  // maximum number of operations in a batch
+  static const uint8_t i2cMaxBatchOperations = 4;
+
+  /// One register access of a batch
+  typedef struct
+  {
+    uint8_t registerAdd; ///< first register to access
+    uint8_t isWrite;     ///< 0 to read registers in \ref buf, 1 to write \ref buf to the registers
+    uint8_t size;        ///< number of bytes to transfer
+    uint8_t* buf;        ///< data to read or write, in an array of size \ref size
+  } i2c_operation;
+
+  /**
+   * \brief Called by the i2c worker when a batch is done
+   * \param[in] result 0 if all the operations succeeded, 1 otherwise
+   * \param[in] userData The pointer given with the batch
+   * Runs on the i2c worker: keep it short, and do not start blocking i2c transfers from it
+   */
+  typedef void (*i2c_callback)(int result, void* userData);
+
+  /**
+   * \brief Do a batch of register accesses on one device, and wait for its completion
+   * \param[in] i2cIndex The index of the i2c interface (from 0 to WIRE_INTERFACES_COUNT - 1)
+   * \param[in] deviceAddr the address of the target device
+   * \param[in] operations the accesses to do, in order
+   * \param[in] count the number of operations (at most \ref i2cMaxBatchOperations)
+   * \param[in] stopBit if > 0, will add a stopBit after each register address and write
+   */
+  extern int i2c_transfer(
+          uint8_t i2cIndex, uint8_t deviceAddr, const i2c_operation* operations, uint8_t count, int stopBit);
+
+  /**
+   * \brief Queue a batch of register accesses on one device, and return without waiting
+   * The operations are copied, but their buffers must stay valid until \ref callback is called
+   * \param[in] i2cIndex The index of the i2c interface (from 0 to WIRE_INTERFACES_COUNT - 1)
+   * \param[in] deviceAddr the address of the target device
+   * \param[in] operations the accesses to do, in order
+   * \param[in] count the number of operations (at most \ref i2cMaxBatchOperations)
+   * \param[in] stopBit if > 0, will add a stopBit after each register address and write
+   * \param[in] callback Called with the batch result when it is done
+   * \param[in] userData Given back to \ref callback
+   */
+  extern int i2c_submit(uint8_t i2cIndex,
+                        uint8_t deviceAddr,
+                        const i2c_operation* operations,
+                        uint8_t count,
+                        int stopBit,
+                        i2c_callback callback,
+                        void* userData);
+
   // define simple low weight handler
 
   /**
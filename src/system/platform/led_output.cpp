@@ -0,0 +1,243 @@
+#ifndef PLATFORM_LED_OUTPUT_CPP
+#define PLATFORM_LED_OUTPUT_CPP
+
+#include "led_output.h"
+
+#include <Arduino.h>
+#include <cstring>
+#include <new>
+
+#include "rtos.h" // tied to FreeRTOS for the output lock
+
+/*
+ * Same PWM timings as the Adafruit_NeoPixel nRF52 driver: at 16MHz, one period
+ * of 20 ticks is one bit (1.25us), the duty cycle encodes the bit value.
+ * Bit 15 set means the output starts high.
+ */
+static constexpr uint16_t periodTicks = 20;
+static constexpr uint16_t bitZero = 6 | 0x8000;  // 0.375us high
+static constexpr uint16_t bitOne = 13 | 0x8000;  // 0.8125us high
+static constexpr uint16_t bitLatch = 0 | 0x8000; // low
+// the strip latches the frame after 300us of low output (240 periods)
+static constexpr uint16_t latchPeriods = 240;
+
+/*
+ * The frame is not expanded at once (16 bits of sequence per bit, 42KB for 870
+ * RGB LEDs): the two PWM sequences play two chunk buffers in turn, and the
+ * interrupt encodes the next chunk in the buffer that just ended.
+ */
+// words of a chunk (64 bytes of frame, 1.28ms of output to encode the next one)
+static constexpr uint16_t chunkWords = 1024;
+static_assert(chunkWords % 8 == 0, "chunks must start on a frame byte");
+// highest application priority (0, 1 and 4 are used by the SoftDevice)
+static constexpr uint8_t irqPriority = 2;
+
+struct PwmInstance
+{
+  NRF_PWM_Type* pwm;
+  IRQn_Type irq;
+};
+
+static const PwmInstance pwmInstances[] = {
+        {NRF_PWM0, PWM0_IRQn}, {NRF_PWM1, PWM1_IRQn}, {NRF_PWM2, PWM2_IRQn}, {NRF_PWM3, PWM3_IRQn}};
+
+static int16_t outputPin = -1;
+static uint16_t outputFrameSize = 0;
+// copy of the frame being sent, read by the interrupt
+static uint8_t* outputFrame = nullptr;
+// chunk buffers of the two sequences, read by the DMA while a transfer is running
+static uint16_t outputChunks[2][chunkWords];
+
+// words to send (frame, then latch), and chunks of the transfer (always even)
+static uint32_t transferWords = 0;
+static uint16_t transferChunks = 0;
+// next chunk to encode, updated by the interrupt
+static volatile uint16_t nextChunk = 0;
+// PWM instance of the running transfer (nullptr if none), released by the interrupt
+static const PwmInstance* volatile activePwm = nullptr;
+
+// serialize the callers: frames can be sent from the main and the user threads
+static SemaphoreHandle_t outputLock = nullptr;
+static StaticSemaphore_t outputLockBuffer;
+
+// find a PWM instance that is not used by analogWrite or the tone library
+static const PwmInstance* find_free_pwm()
+{
+  for (const PwmInstance& instance: pwmInstances)
+  {
+    NRF_PWM_Type* pwm = instance.pwm;
+    if (pwm->ENABLE == 0 and (pwm->PSEL.OUT[0] & PWM_PSEL_OUT_CONNECT_Msk) and
+        (pwm->PSEL.OUT[1] & PWM_PSEL_OUT_CONNECT_Msk) and (pwm->PSEL.OUT[2] & PWM_PSEL_OUT_CONNECT_Msk) and
+        (pwm->PSEL.OUT[3] & PWM_PSEL_OUT_CONNECT_Msk))
+    {
+      return &instance;
+    }
+  }
+  return nullptr;
+}
+
+// number of words of a chunk (the last ones can be shorter)
+static uint16_t chunk_size(const uint16_t chunk)
+{
+  const uint32_t first = static_cast<uint32_t>(chunk) * chunkWords;
+  if (first >= transferWords)
+    // padding chunk, to end on the second sequence
+    return 1;
+  const uint32_t remaining = transferWords - first;
+  return (remaining < chunkWords) ? remaining : chunkWords;
+}
+
+// expand a chunk of the frame in the buffer of sequence \p seqIndex
+static void encode_chunk(NRF_PWM_Type* pwm, const uint8_t seqIndex, const uint16_t chunk)
+{
+  uint16_t* seq = outputChunks[seqIndex];
+  const uint16_t size = chunk_size(chunk);
+  const uint32_t first = static_cast<uint32_t>(chunk) * chunkWords;
+
+  uint16_t written = 0;
+  for (uint32_t i = first / 8; i < outputFrameSize and written < size; ++i)
+  {
+    const uint8_t b = outputFrame[i];
+    for (uint8_t mask = 0x80; mask != 0; mask >>= 1)
+    {
+      seq[written++] = (b & mask) ? bitOne : bitZero;
+    }
+  }
+  // past the frame: low output, the strip latches
+  while (written < size)
+  {
+    seq[written++] = bitLatch;
+  }
+
+  // only used when this sequence starts again (after the other one)
+  pwm->SEQ[seqIndex].CNT = size << PWM_SEQ_CNT_CNT_Pos;
+}
+
+static void on_pwm_event()
+{
+  const PwmInstance* instance = activePwm;
+  if (instance == nullptr)
+    return;
+  NRF_PWM_Type* pwm = instance->pwm;
+
+  for (uint8_t seqIndex = 0; seqIndex < 2; ++seqIndex)
+  {
+    if (pwm->EVENTS_SEQEND[seqIndex] == 0)
+      continue;
+    pwm->EVENTS_SEQEND[seqIndex] = 0;
+    (void)pwm->EVENTS_SEQEND[seqIndex];
+
+    // the other sequence plays, refill this one
+    const uint16_t chunk = nextChunk;
+    if (chunk < transferChunks)
+    {
+      encode_chunk(pwm, seqIndex, chunk);
+      nextChunk = chunk + 1;
+    }
+  }
+
+  if (pwm->EVENTS_LOOPSDONE != 0)
+  {
+    pwm->EVENTS_LOOPSDONE = 0;
+    (void)pwm->EVENTS_LOOPSDONE;
+
+    pwm->INTENCLR = 0xFFFFFFFFUL;
+    NVIC_DisableIRQ(instance->irq);
+    pwm->ENABLE = 0;
+    pwm->PSEL.OUT[0] = 0xFFFFFFFFUL;
+    activePwm = nullptr;
+  }
+}
+
+extern "C" {
+void PWM0_IRQHandler(void) { on_pwm_event(); }
+void PWM1_IRQHandler(void) { on_pwm_event(); }
+void PWM2_IRQHandler(void) { on_pwm_event(); }
+void PWM3_IRQHandler(void) { on_pwm_event(); }
+}
+
+bool led_output_setup(const int16_t pin, const uint16_t frameSize)
+{
+  if (outputLock == nullptr)
+    outputLock = xSemaphoreCreateMutexStatic(&outputLockBuffer);
+
+  xSemaphoreTake(outputLock, portMAX_DELAY);
+  led_output_wait();
+
+  delete[] outputFrame;
+  outputFrame = new (std::nothrow) uint8_t[frameSize];
+  const bool isAllocated = (outputFrame != nullptr);
+  outputPin = pin;
+  outputFrameSize = isAllocated ? frameSize : 0;
+
+  xSemaphoreGive(outputLock);
+  return isAllocated;
+}
+
+bool led_output_send(const uint8_t* frame)
+{
+  if (outputFrame == nullptr)
+    return false;
+
+  xSemaphoreTake(outputLock, portMAX_DELAY);
+  // the frame copy is read by the interrupt until the end of the previous frame
+  led_output_wait();
+
+  const PwmInstance* instance = find_free_pwm();
+  if (instance == nullptr)
+  {
+    xSemaphoreGive(outputLock);
+    return false;
+  }
+  NRF_PWM_Type* pwm = instance->pwm;
+
+  memcpy(outputFrame, frame, outputFrameSize);
+  transferWords = static_cast<uint32_t>(outputFrameSize) * 8 + latchPeriods;
+  transferChunks = (transferWords + chunkWords - 1) / chunkWords;
+  // the sequences are played in pairs
+  transferChunks += transferChunks % 2;
+
+  pwm->MODE = (PWM_MODE_UPDOWN_Up << PWM_MODE_UPDOWN_Pos);
+  pwm->PRESCALER = (PWM_PRESCALER_PRESCALER_DIV_1 << PWM_PRESCALER_PRESCALER_Pos);
+  pwm->COUNTERTOP = (periodTicks << PWM_COUNTERTOP_COUNTERTOP_Pos);
+  pwm->LOOP = ((transferChunks / 2) << PWM_LOOP_CNT_Pos);
+  pwm->SHORTS = 0;
+  pwm->DECODER = (PWM_DECODER_LOAD_Common << PWM_DECODER_LOAD_Pos) |
+                 (PWM_DECODER_MODE_RefreshCount << PWM_DECODER_MODE_Pos);
+  for (uint8_t seqIndex = 0; seqIndex < 2; ++seqIndex)
+  {
+    pwm->SEQ[seqIndex].PTR = reinterpret_cast<uint32_t>(outputChunks[seqIndex]) << PWM_SEQ_PTR_PTR_Pos;
+    pwm->SEQ[seqIndex].REFRESH = 0;
+    // the latch is part of the sequence, an end delay would be added after each chunk
+    pwm->SEQ[seqIndex].ENDDELAY = 0;
+    encode_chunk(pwm, seqIndex, seqIndex);
+  }
+  nextChunk = 2;
+  pwm->PSEL.OUT[0] = g_ADigitalPinMap[outputPin];
+
+  pwm->ENABLE = 1;
+  pwm->EVENTS_SEQEND[0] = 0;
+  pwm->EVENTS_SEQEND[1] = 0;
+  pwm->EVENTS_LOOPSDONE = 0;
+  activePwm = instance;
+  pwm->INTENSET = PWM_INTENSET_SEQEND0_Msk | PWM_INTENSET_SEQEND1_Msk | PWM_INTENSET_LOOPSDONE_Msk;
+  NVIC_ClearPendingIRQ(instance->irq);
+  NVIC_SetPriority(instance->irq, irqPriority);
+  NVIC_EnableIRQ(instance->irq);
+  pwm->TASKS_SEQSTART[0] = 1;
+
+  xSemaphoreGive(outputLock);
+  return true;
+}
+
+bool led_output_is_busy(void) { return activePwm != nullptr; }
+
+void led_output_wait(void)
+{
+  while (activePwm != nullptr)
+  {
+    yield();
+  }
+}
+
+#endif
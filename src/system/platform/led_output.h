@@ -0,0 +1,48 @@
+// do not use pragma once here, has this can be mocked
+#ifndef PLATFORM_LED_OUTPUT
+#define PLATFORM_LED_OUTPUT
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+  /**
+   * Asynchronous output of a LED strip (800KHz neopixel protocol)
+   *
+   * A frame (strip wire format, as encoded in the Adafruit_NeoPixel buffer) is
+   * copied by the driver, then expanded by chunks to the output sequence that
+   * is clocked out by DMA. The caller can render and encode the next frame
+   * while the transfer runs. All functions can be called from any thread.
+   */
+
+  /**
+   * \brief Setup the output of frames of \p frameSize bytes on \p pin
+   * \return false if the frame copy could not be allocated (use the blocking output instead)
+   */
+  extern bool led_output_setup(const int16_t pin, const uint16_t frameSize);
+
+  /**
+   * \brief Start the transfer of \p frame, and return without waiting for its end
+   * Only waits for the previous transfer to complete (the completion fence).
+   * \p frame is not used anymore when this returns, and can be modified.
+   * \return false if the transfer could not be started (no free DMA output)
+   */
+  extern bool led_output_send(const uint8_t* frame);
+
+  /**
+   * \brief Return true while a frame (and the strip latch delay) is being transfered
+   */
+  extern bool led_output_is_busy(void);
+
+  /**
+   * \brief Completion fence: wait for the end of the current transfer, if any
+   */
+  extern void led_output_wait(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -9,31 +9,37 @@
 
 namespace microphone {
 
-FftAnalyzer<PdmData::SAMPLE_SIZE, SoundStruct::numberOfFFtChanels> fftAnalyzer;
+FftAnalyzer<PdmData::SAMPLE_SIZE, SoundStruct::numberOfFFtChanels, FixedFftBackend> fftAnalyzer;
 
-PdmData lastData;
+PdmRing pdmRing;
 
-// callback every time the microphone reads data
+// callback every time the microphone reads data (interrupt context)
 void on_PDM_data()
 {
-  lastData.sampleRead = 0;
-  const uint32_t newTime = time_us();
+  // never one of the blocks borrowed by the readers
+  PdmData& block = pdmRing.write_slot();
 
-  lastData.sampleDuration_us = newTime - lastData.sampleTime_us;
-  lastData.sampleTime_us = newTime;
+  const uint32_t newTime = time_us();
+  block.sampleDuration_us = newTime - pdmRing.latest().sampleTime_us;
+  block.sampleTime_us = newTime;
   // query the number of bytes available
   const uint16_t bytesAvailable = min(PDM.available(), PdmData::SAMPLE_SIZE * 2);
 
   // read into the sample buffer
-  PDM.read((char*)&lastData.data[0], bytesAvailable);
+  PDM.read((char*)&block.data[0], bytesAvailable);
 
   // number of samples read
-  lastData.sampleRead = bytesAvailable / 2;
+  block.sampleRead = bytesAvailable / 2;
+  block.update_sum_of_squares();
+  block.sequence = pdmRing.latest_sequence() + 1;
+  pdmRing.publish();
 }
 
 namespace _private {
 
-PdmData get() { return lastData; }
+const PdmData& get() { return pdmRing.latest(); }
+
+const PdmData* get(const uint32_t sequence) { return pdmRing.get(sequence); }
 
 bool start()
 {
@@ -84,7 +90,7 @@ bool processFFT(const PdmData& data, const bool runFFT = true)
 
 static SoundStruct soundStruct;
 
-SoundStruct process_fft(const PdmData& data)
+const SoundStruct& process_fft(const PdmData& data)
 {
   // process the sound input
   if (!processFFT(data, true))
@@ -4,6 +4,8 @@
 #include <stdint.h>
 #include <cstddef>
 
+#include "src/system/utils/spsc_ring.h"
+
 namespace microphone {
 
 struct PdmData
@@ -16,8 +18,22 @@ struct PdmData
 
   // number of sound sample in array
   uint32_t sampleRead = 0;
+  // position of this block in the stream of microphone blocks (0: never written)
+  uint32_t sequence = 0;
+  // sum of the squared samples, for the sound level
+  uint64_t sumOfSquares = 0;
 
   bool is_valid() const { return sampleRead > 0; } // and (time_us() - sampleTime_us) < 200; }
+
+  // (producer) accumulate sumOfSquares, once the samples are read
+  void update_sum_of_squares()
+  {
+    sumOfSquares = 0;
+    for (uint32_t i = 0; i < sampleRead; i++)
+    {
+      sumOfSquares += static_cast<int32_t>(data[i]) * data[i];
+    }
+  }
 };
 
 struct SoundStruct
@@ -32,9 +48,17 @@ struct SoundStruct
   uint8_t fft[numberOfFFtChanels];
 };
 
+// blocks of samples: the microphone callback writes one while the others are read
+using PdmRing = SpscRing<PdmData, 4>;
+
 namespace _private {
 
-PdmData get();
+// last complete block of samples, not copied: read it before the microphone
+// callback publishes PdmRing::readableCount new blocks (~32ms each)
+const PdmData& get();
+
+// recent block of samples by sequence (nullptr if too old), for overlapping windows
+const PdmData* get(const uint32_t sequence);
 
 // start the microphone readings
 bool start();
@@ -43,9 +67,9 @@ void stop();
 
 /**
  * \brief compute the fast fourrier transform of the most recent sound sample
- * \return The frequency analysis object
+ * \return The frequency analysis object, valid until the next call
  */
-SoundStruct process_fft(const PdmData& data);
+const SoundStruct& process_fft(const PdmData& data);
 
 } // namespace _private
 
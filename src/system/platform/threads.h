@@ -12,6 +12,7 @@ extern "C" {
   const char* const power_taskName = "power";
   const char* const user_taskName = "user";
   const char* const taskScheduler_taskName = "task_sched";
+  const char* const i2c_taskName = "i2c";
 
   typedef void (*taskfunc_t)(void);
   /**
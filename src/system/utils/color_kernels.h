@@ -0,0 +1,155 @@
+#ifndef COLOR_KERNELS_H
+#define COLOR_KERNELS_H
+
+#include <cstdint>
+
+#if defined(__ARM_FEATURE_SIMD32) && !defined(LMBD_SIMULATION)
+#include <arm_acle.h>
+#define LMBD_COLOR_KERNELS_SIMD32
+#endif
+
+/**
+ * \brief Color math on whole packed 0xWWRRGGBB words
+ *
+ * The four channels are processed at once: two 16-bit lanes per 32-bit word
+ * (even bytes, then odd bytes), or the DSP SIMD instructions of the Cortex-M4
+ * when available. Results are bit-exact with the per-channel functions of
+ * utils.h (scale8, scale8_video, qadd8, color_blend).
+ *
+ * All but add are constexpr, to be usable in the compile-time color helpers.
+ */
+namespace utils::kernels {
+
+static constexpr uint32_t evenMask = 0x00ff00ff;
+static constexpr uint32_t oddMask = 0xff00ff00;
+
+/// All channels: c * f / 256 (rounded down), with \p f in range 0-256
+static constexpr uint32_t mul(const uint32_t c, const uint16_t f)
+{
+  const uint32_t even = (((c & evenMask) * f) >> 8) & evenMask;
+  const uint32_t odd = (((c >> 8) & evenMask) * f) & oddMask;
+  return even | odd;
+}
+
+/// 1 in all channels of \p c that are not 0
+static constexpr uint32_t lit(const uint32_t c)
+{
+  // (x + 0xff) has bit 8 set if x != 0
+  const uint32_t even = (((c & evenMask) + evenMask) >> 8) & 0x00010001;
+  const uint32_t odd = ((((c >> 8) & evenMask) + evenMask) >> 8) & 0x00010001;
+  return even | (odd << 8);
+}
+
+/// Same as scale8 on all channels: c * (1 + s) / 256
+static constexpr uint32_t scale(const uint32_t c, const uint8_t s) { return mul(c, 1 + s); }
+
+/// Same as scale8 + 1 on all lit channels of \p c (\p s must be lower than 255)
+static constexpr uint32_t scale_lit(const uint32_t c, const uint8_t s) { return mul(c, 1 + s) + lit(c); }
+
+/// All channels: a * (255 - t) / 256 + b * t / 256, each term rounded down
+static constexpr uint32_t interpolate(const uint32_t a, const uint32_t b, const uint8_t t)
+{
+  return mul(a, 255 - t) + mul(b, t);
+}
+
+/// Same as scale8_video on all channels: a lit channel never goes to black
+static constexpr uint32_t scale_video(const uint32_t c, const uint8_t s)
+{
+  if (s == 0)
+    return 0;
+  return mul(c, s) + lit(c);
+}
+
+/// Same as qadd8 on all channels (saturating add)
+static inline uint32_t add(const uint32_t a, const uint32_t b)
+{
+#ifdef LMBD_COLOR_KERNELS_SIMD32
+  return __uqadd8(a, b);
+#else
+  const uint32_t even = (a & evenMask) + (b & evenMask);
+  const uint32_t odd = ((a >> 8) & evenMask) + ((b >> 8) & evenMask);
+  // a lane carry becomes 0xff in that lane
+  const uint32_t evenCarry = even & 0x01000100;
+  const uint32_t oddCarry = odd & 0x01000100;
+  const uint32_t evenSat = (even | (evenCarry - (evenCarry >> 8))) & evenMask;
+  const uint32_t oddSat = (odd | (oddCarry - (oddCarry >> 8))) & evenMask;
+  return evenSat | (oddSat << 8);
+#endif
+}
+
+/// Same as color_blend (8 bits): \p amount of \p b over \p a
+static constexpr uint32_t blend(const uint32_t a, const uint32_t b, const uint8_t amount)
+{
+  if (amount == 0)
+    return a;
+  if (amount == 255)
+    return b;
+
+  const uint32_t inv = 255 - amount;
+  const uint32_t even = (((b & evenMask) * amount + (a & evenMask) * inv) >> 8) & evenMask;
+  const uint32_t odd = (((b >> 8) & evenMask) * amount + ((a >> 8) & evenMask) * inv) & oddMask;
+  return even | odd;
+}
+
+/// scale all \p count colors of \p buffer by \p s (see scale)
+static inline void scale_span(uint32_t* buffer, const uint16_t count, const uint8_t s)
+{
+  if (s == 255)
+    return;
+  for (uint16_t i = 0; i < count; ++i)
+  {
+    buffer[i] = scale(buffer[i], s);
+  }
+}
+
+/// saturating add of \p count colors of \p src into \p dst
+static inline void add_span(uint32_t* dst, const uint32_t* src, const uint16_t count)
+{
+  for (uint16_t i = 0; i < count; ++i)
+  {
+    dst[i] = add(dst[i], src[i]);
+  }
+}
+
+/// write to \p dst the blend of \p a and \p b, \p amount of \p b over \p a (only the channels set in \p keepMask)
+static inline void blend_span(uint32_t* dst,
+                              const uint32_t* a,
+                              const uint32_t* b,
+                              const uint16_t count,
+                              const uint8_t amount,
+                              const uint32_t keepMask = 0xffffffff)
+{
+  for (uint16_t i = 0; i < count; ++i)
+  {
+    dst[i] = blend(a[i], b[i], amount) & keepMask;
+  }
+}
+
+/**
+ * \brief Blur \p count colors of \p buffer, each color sharing \p amount / 2
+ * with each of its neighbors (same as the FastLED blur1d)
+ */
+static inline void blur_span(uint32_t* buffer, const uint16_t count, const uint8_t amount)
+{
+  if (amount == 0 or count == 0)
+    return;
+
+  const uint8_t keep = 255 - amount;
+  const uint8_t seep = amount >> 1;
+  uint32_t carryover = 0;
+  for (uint16_t i = 0; i < count; ++i)
+  {
+    const uint32_t cur = buffer[i];
+    const uint32_t part = scale(cur, seep);
+    if (i > 0)
+    {
+      buffer[i - 1] = add(buffer[i - 1], part);
+    }
+    buffer[i] = add(scale(cur, keep), carryover);
+    carryover = part;
+  }
+}
+
+} // namespace utils::kernels
+
+#endif
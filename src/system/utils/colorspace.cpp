@@ -2,50 +2,312 @@
 
 #include "utils.h"
 
+#include <cmath>
+#include <cstring>
+
 namespace utils::ColorSpace {
 
-COLOR XYZ::get_rgb() const
+// single precision math only: the microcontroler FPU does not handle doubles
+
+// entries of the linear to sRGB table (the dark tones need more than 256)
+static constexpr uint16_t gammaEncodeSize = 4096;
+
+// precomputed tables, kept in flash (no startup cost, no RAM)
+
+// c = i / 255, (c > 0.04045) ? ((c + 0.055) / 1.055)^2.4 : c / 12.92, in single precision
+static constexpr float gammaDecodeTable[256] = {
+        0.0f, 0.000303526991f, 0.000607053982f, 0.000910580973f, 0.00121410796f, 0.00151763496f, 0.00182116195f,
+        0.00212468882f, 0.00242821593f, 0.00273174304f, 0.00303526991f, 0.00334653561f, 0.00367650692f, 0.00402471703f,
+        0.00439144205f, 0.00477695325f, 0.00518151699f, 0.00560539169f, 0.00604883255f, 0.00651209103f, 0.00699541019f,
+        0.00749903172f, 0.00802319217f, 0.00856812485f, 0.00913405698f, 0.00972121768f, 0.010329823f, 0.0109600937f,
+        0.0116122449f, 0.012286487f, 0.0129830306f, 0.0137020806f, 0.0144438436f, 0.0152085144f, 0.0159962922f,
+        0.0168073755f, 0.0176419523f, 0.0185002182f, 0.0193823613f, 0.0202885624f, 0.0212190095f, 0.0221738834f,
+        0.0231533647f, 0.0241576303f, 0.0251868572f, 0.0262412224f, 0.0273208916f, 0.0284260381f, 0.0295568332f,
+        0.0307134409f, 0.0318960287f, 0.0331047624f, 0.0343398079f, 0.0356013142f, 0.036889445f, 0.0382043645f,
+        0.0395462364f, 0.0409151986f, 0.0423114114f, 0.0437350273f, 0.045186203f, 0.0466650836f, 0.048171822f,
+        0.0497065634f, 0.0512694679f, 0.0528606549f, 0.0544802807f, 0.0561284944f, 0.0578054339f, 0.0595112406f,
+        0.061246071f, 0.0630100295f, 0.0648032799f, 0.0666259527f, 0.068478182f, 0.0703601092f, 0.0722718611f,
+        0.0742135793f, 0.0761853904f, 0.0781874284f, 0.0802198276f, 0.0822827145f, 0.0843762159f, 0.0865004659f,
+        0.0886556059f, 0.0908417329f, 0.093058981f, 0.0953074843f, 0.0975873619f, 0.0998987406f, 0.102241747f,
+        0.104616493f, 0.107023112f, 0.109461717f, 0.111932434f, 0.114435382f, 0.116970673f, 0.119538434f, 0.122138798f,
+        0.124771841f, 0.127437696f, 0.13013649f, 0.132868335f, 0.135633349f, 0.138431624f, 0.141263306f, 0.144128487f,
+        0.147027284f, 0.149959803f, 0.152926162f, 0.155926466f, 0.158960864f, 0.1620294f, 0.165132225f, 0.168269396f,
+        0.171441093f, 0.174647391f, 0.177888408f, 0.181164235f, 0.18447499f, 0.187820762f, 0.191201672f, 0.194617808f,
+        0.198069304f, 0.201556236f, 0.205078706f, 0.20863685f, 0.212230727f, 0.215860531f, 0.219526231f, 0.223227978f,
+        0.226965889f, 0.23074007f, 0.234550655f, 0.238397658f, 0.242281199f, 0.246201396f, 0.25015837f, 0.254152179f,
+        0.258182913f, 0.262250721f, 0.266355664f, 0.270497859f, 0.274677366f, 0.278894335f, 0.283148795f, 0.287440896f,
+        0.291770697f, 0.296138316f, 0.300543845f, 0.304987371f, 0.309468955f, 0.313988745f, 0.318546832f, 0.323143244f,
+        0.327778131f, 0.332451582f, 0.337163657f, 0.341914445f, 0.346704096f, 0.351532698f, 0.356400251f, 0.361306876f,
+        0.366252691f, 0.371237785f, 0.376262218f, 0.381326109f, 0.386429518f, 0.391572565f, 0.396755308f, 0.401977867f,
+        0.407240301f, 0.412542701f, 0.417885154f, 0.423267752f, 0.428690553f, 0.434153706f, 0.439657241f, 0.445201248f,
+        0.450785846f, 0.456411064f, 0.462077051f, 0.467783839f, 0.473531544f, 0.479320228f, 0.48514998f, 0.491020888f,
+        0.496933043f, 0.502886593f, 0.50888145f, 0.514917791f, 0.520995677f, 0.527115226f, 0.533276498f, 0.539479613f,
+        0.545724571f, 0.55201149f, 0.55834049f, 0.56471163f, 0.571124911f, 0.577580512f, 0.584078491f, 0.590618908f,
+        0.597201884f, 0.603827417f, 0.610495627f, 0.617206633f, 0.623960435f, 0.630757213f, 0.637596965f, 0.644479752f,
+        0.651405692f, 0.658374846f, 0.665387332f, 0.672443211f, 0.679542542f, 0.686685443f, 0.693871915f, 0.701102018f,
+        0.708375931f, 0.715693653f, 0.723055243f, 0.730460882f, 0.737910569f, 0.745404363f, 0.752942324f, 0.760524631f,
+        0.768151283f, 0.775822341f, 0.783537924f, 0.791298032f, 0.799102843f, 0.806952357f, 0.814846694f, 0.822785854f,
+        0.830769956f, 0.838799119f, 0.846873283f, 0.854992688f, 0.863157272f, 0.871367216f, 0.87962234f, 0.887923181f,
+        0.896269381f, 0.904661357f, 0.913098693f, 0.921582043f, 0.930110872f, 0.938685894f, 0.947306573f, 0.955973506f,
+        0.964686275f, 0.973445475f, 0.982250571f, 0.991102219f, 1.0f};
+
+// c = i / 4095, ((c > 0.0031308) ? 1.055 * c^(1 / 2.4) - 0.055 : 12.92 * c) * 255, truncated
+static constexpr uint8_t gammaEncodeTable[gammaEncodeSize] = {
+        0,   0,   1,   2,   3,   4,   4,   5,   6,   7,   8,   8,   9,   10,  11,  11,  12,  13,  14,  14,  15,  15,
+        16,  17,  17,  18,  18,  19,  19,  20,  20,  21,  21,  22,  22,  22,  23,  23,  24,  24,  25,  25,  25,  26,
+        26,  27,  27,  27,  28,  28,  28,  29,  29,  29,  30,  30,  30,  31,  31,  31,  32,  32,  32,  33,  33,  33,
+        34,  34,  34,  35,  35,  35,  35,  36,  36,  36,  37,  37,  37,  37,  38,  38,  38,  38,  39,  39,  39,  40,
+        40,  40,  40,  41,  41,  41,  41,  42,  42,  42,  42,  43,  43,  43,  43,  43,  44,  44,  44,  44,  45,  45,
+        45,  45,  46,  46,  46,  46,  46,  47,  47,  47,  47,  47,  48,  48,  48,  48,  49,  49,  49,  49,  49,  50,
+        50,  50,  50,  50,  51,  51,  51,  51,  51,  52,  52,  52,  52,  52,  53,  53,  53,  53,  53,  53,  54,  54,
+        54,  54,  54,  55,  55,  55,  55,  55,  56,  56,  56,  56,  56,  56,  57,  57,  57,  57,  57,  57,  58,  58,
+        58,  58,  58,  58,  59,  59,  59,  59,  59,  59,  60,  60,  60,  60,  60,  60,  61,  61,  61,  61,  61,  61,
+        62,  62,  62,  62,  62,  62,  63,  63,  63,  63,  63,  63,  64,  64,  64,  64,  64,  64,  64,  65,  65,  65,
+        65,  65,  65,  65,  66,  66,  66,  66,  66,  66,  67,  67,  67,  67,  67,  67,  67,  68,  68,  68,  68,  68,
+        68,  68,  69,  69,  69,  69,  69,  69,  69,  70,  70,  70,  70,  70,  70,  70,  70,  71,  71,  71,  71,  71,
+        71,  71,  72,  72,  72,  72,  72,  72,  72,  73,  73,  73,  73,  73,  73,  73,  73,  74,  74,  74,  74,  74,
+        74,  74,  74,  75,  75,  75,  75,  75,  75,  75,  76,  76,  76,  76,  76,  76,  76,  76,  77,  77,  77,  77,
+        77,  77,  77,  77,  78,  78,  78,  78,  78,  78,  78,  78,  78,  79,  79,  79,  79,  79,  79,  79,  79,  80,
+        80,  80,  80,  80,  80,  80,  80,  81,  81,  81,  81,  81,  81,  81,  81,  81,  82,  82,  82,  82,  82,  82,
+        82,  82,  82,  83,  83,  83,  83,  83,  83,  83,  83,  83,  84,  84,  84,  84,  84,  84,  84,  84,  85,  85,
+        85,  85,  85,  85,  85,  85,  85,  85,  86,  86,  86,  86,  86,  86,  86,  86,  86,  87,  87,  87,  87,  87,
+        87,  87,  87,  87,  88,  88,  88,  88,  88,  88,  88,  88,  88,  88,  89,  89,  89,  89,  89,  89,  89,  89,
+        89,  90,  90,  90,  90,  90,  90,  90,  90,  90,  90,  91,  91,  91,  91,  91,  91,  91,  91,  91,  91,  92,
+        92,  92,  92,  92,  92,  92,  92,  92,  92,  93,  93,  93,  93,  93,  93,  93,  93,  93,  93,  94,  94,  94,
+        94,  94,  94,  94,  94,  94,  94,  95,  95,  95,  95,  95,  95,  95,  95,  95,  95,  96,  96,  96,  96,  96,
+        96,  96,  96,  96,  96,  96,  97,  97,  97,  97,  97,  97,  97,  97,  97,  97,  97,  98,  98,  98,  98,  98,
+        98,  98,  98,  98,  98,  99,  99,  99,  99,  99,  99,  99,  99,  99,  99,  99,  100, 100, 100, 100, 100, 100,
+        100, 100, 100, 100, 100, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 102, 102, 102, 102, 102,
+        102, 102, 102, 102, 102, 102, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 104, 104, 104, 104, 104,
+        104, 104, 104, 104, 104, 104, 104, 105, 105, 105, 105, 105, 105, 105, 105, 105, 105, 105, 105, 106, 106, 106,
+        106, 106, 106, 106, 106, 106, 106, 106, 106, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 108,
+        108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 109, 109, 109, 109, 109, 109, 109, 109, 109, 109, 109,
+        109, 110, 110, 110, 110, 110, 110, 110, 110, 110, 110, 110, 110, 111, 111, 111, 111, 111, 111, 111, 111, 111,
+        111, 111, 111, 111, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 113, 113, 113, 113, 113,
+        113, 113, 113, 113, 113, 113, 113, 113, 114, 114, 114, 114, 114, 114, 114, 114, 114, 114, 114, 114, 114, 115,
+        115, 115, 115, 115, 115, 115, 115, 115, 115, 115, 115, 115, 116, 116, 116, 116, 116, 116, 116, 116, 116, 116,
+        116, 116, 116, 117, 117, 117, 117, 117, 117, 117, 117, 117, 117, 117, 117, 117, 118, 118, 118, 118, 118, 118,
+        118, 118, 118, 118, 118, 118, 118, 118, 119, 119, 119, 119, 119, 119, 119, 119, 119, 119, 119, 119, 119, 119,
+        120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 120, 121, 121, 121, 121, 121, 121, 121, 121, 121,
+        121, 121, 121, 121, 121, 122, 122, 122, 122, 122, 122, 122, 122, 122, 122, 122, 122, 122, 122, 122, 123, 123,
+        123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 124, 124, 124, 124, 124, 124, 124, 124, 124, 124,
+        124, 124, 124, 124, 125, 125, 125, 125, 125, 125, 125, 125, 125, 125, 125, 125, 125, 125, 125, 126, 126, 126,
+        126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127,
+        127, 127, 127, 127, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 129, 129, 129,
+        129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 130, 130, 130, 130, 130, 130, 130, 130, 130,
+        130, 130, 130, 130, 130, 130, 131, 131, 131, 131, 131, 131, 131, 131, 131, 131, 131, 131, 131, 131, 131, 132,
+        132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 132, 133, 133, 133, 133, 133, 133, 133,
+        133, 133, 133, 133, 133, 133, 133, 133, 133, 134, 134, 134, 134, 134, 134, 134, 134, 134, 134, 134, 134, 134,
+        134, 134, 134, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 135, 136, 136, 136,
+        136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 137, 137, 137, 137, 137, 137, 137, 137, 137,
+        137, 137, 137, 137, 137, 137, 137, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138,
+        138, 138, 139, 139, 139, 139, 139, 139, 139, 139, 139, 139, 139, 139, 139, 139, 139, 139, 140, 140, 140, 140,
+        140, 140, 140, 140, 140, 140, 140, 140, 140, 140, 140, 140, 140, 141, 141, 141, 141, 141, 141, 141, 141, 141,
+        141, 141, 141, 141, 141, 141, 141, 141, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142, 142,
+        142, 142, 142, 143, 143, 143, 143, 143, 143, 143, 143, 143, 143, 143, 143, 143, 143, 143, 143, 143, 143, 144,
+        144, 144, 144, 144, 144, 144, 144, 144, 144, 144, 144, 144, 144, 144, 144, 144, 145, 145, 145, 145, 145, 145,
+        145, 145, 145, 145, 145, 145, 145, 145, 145, 145, 145, 145, 146, 146, 146, 146, 146, 146, 146, 146, 146, 146,
+        146, 146, 146, 146, 146, 146, 146, 147, 147, 147, 147, 147, 147, 147, 147, 147, 147, 147, 147, 147, 147, 147,
+        147, 147, 147, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 149,
+        149, 149, 149, 149, 149, 149, 149, 149, 149, 149, 149, 149, 149, 149, 149, 149, 149, 150, 150, 150, 150, 150,
+        150, 150, 150, 150, 150, 150, 150, 150, 150, 150, 150, 150, 150, 150, 151, 151, 151, 151, 151, 151, 151, 151,
+        151, 151, 151, 151, 151, 151, 151, 151, 151, 151, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152, 152,
+        152, 152, 152, 152, 152, 152, 152, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153,
+        153, 153, 153, 153, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154,
+        154, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 155, 156, 156,
+        156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 157, 157, 157, 157, 157,
+        157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 158, 158, 158, 158, 158, 158, 158,
+        158, 158, 158, 158, 158, 158, 158, 158, 158, 158, 158, 158, 159, 159, 159, 159, 159, 159, 159, 159, 159, 159,
+        159, 159, 159, 159, 159, 159, 159, 159, 159, 159, 160, 160, 160, 160, 160, 160, 160, 160, 160, 160, 160, 160,
+        160, 160, 160, 160, 160, 160, 160, 160, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161, 161,
+        161, 161, 161, 161, 161, 161, 162, 162, 162, 162, 162, 162, 162, 162, 162, 162, 162, 162, 162, 162, 162, 162,
+        162, 162, 162, 162, 163, 163, 163, 163, 163, 163, 163, 163, 163, 163, 163, 163, 163, 163, 163, 163, 163, 163,
+        163, 163, 163, 164, 164, 164, 164, 164, 164, 164, 164, 164, 164, 164, 164, 164, 164, 164, 164, 164, 164, 164,
+        164, 165, 165, 165, 165, 165, 165, 165, 165, 165, 165, 165, 165, 165, 165, 165, 165, 165, 165, 165, 165, 165,
+        166, 166, 166, 166, 166, 166, 166, 166, 166, 166, 166, 166, 166, 166, 166, 166, 166, 166, 166, 166, 166, 167,
+        167, 167, 167, 167, 167, 167, 167, 167, 167, 167, 167, 167, 167, 167, 167, 167, 167, 167, 167, 167, 168, 168,
+        168, 168, 168, 168, 168, 168, 168, 168, 168, 168, 168, 168, 168, 168, 168, 168, 168, 168, 168, 169, 169, 169,
+        169, 169, 169, 169, 169, 169, 169, 169, 169, 169, 169, 169, 169, 169, 169, 169, 169, 169, 169, 170, 170, 170,
+        170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170, 171, 171, 171, 171,
+        171, 171, 171, 171, 171, 171, 171, 171, 171, 171, 171, 171, 171, 171, 171, 171, 171, 171, 172, 172, 172, 172,
+        172, 172, 172, 172, 172, 172, 172, 172, 172, 172, 172, 172, 172, 172, 172, 172, 172, 172, 173, 173, 173, 173,
+        173, 173, 173, 173, 173, 173, 173, 173, 173, 173, 173, 173, 173, 173, 173, 173, 173, 173, 174, 174, 174, 174,
+        174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 174, 175, 175, 175, 175,
+        175, 175, 175, 175, 175, 175, 175, 175, 175, 175, 175, 175, 175, 175, 175, 175, 175, 175, 176, 176, 176, 176,
+        176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 176, 177, 177, 177,
+        177, 177, 177, 177, 177, 177, 177, 177, 177, 177, 177, 177, 177, 177, 177, 177, 177, 177, 177, 177, 178, 178,
+        178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 179, 179,
+        179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179,
+        180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180,
+        180, 181, 181, 181, 181, 181, 181, 181, 181, 181, 181, 181, 181, 181, 181, 181, 181, 181, 181, 181, 181, 181,
+        181, 181, 182, 182, 182, 182, 182, 182, 182, 182, 182, 182, 182, 182, 182, 182, 182, 182, 182, 182, 182, 182,
+        182, 182, 182, 182, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183,
+        183, 183, 183, 183, 183, 184, 184, 184, 184, 184, 184, 184, 184, 184, 184, 184, 184, 184, 184, 184, 184, 184,
+        184, 184, 184, 184, 184, 184, 184, 185, 185, 185, 185, 185, 185, 185, 185, 185, 185, 185, 185, 185, 185, 185,
+        185, 185, 185, 185, 185, 185, 185, 185, 185, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186,
+        186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 186, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187,
+        187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 188, 188, 188, 188, 188, 188, 188, 188,
+        188, 188, 188, 188, 188, 188, 188, 188, 188, 188, 188, 188, 188, 188, 188, 188, 189, 189, 189, 189, 189, 189,
+        189, 189, 189, 189, 189, 189, 189, 189, 189, 189, 189, 189, 189, 189, 189, 189, 189, 189, 189, 190, 190, 190,
+        190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190, 190,
+        191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191, 191,
+        191, 191, 191, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192,
+        192, 192, 192, 192, 192, 192, 193, 193, 193, 193, 193, 193, 193, 193, 193, 193, 193, 193, 193, 193, 193, 193,
+        193, 193, 193, 193, 193, 193, 193, 193, 193, 193, 194, 194, 194, 194, 194, 194, 194, 194, 194, 194, 194, 194,
+        194, 194, 194, 194, 194, 194, 194, 194, 194, 194, 194, 194, 194, 195, 195, 195, 195, 195, 195, 195, 195, 195,
+        195, 195, 195, 195, 195, 195, 195, 195, 195, 195, 195, 195, 195, 195, 195, 195, 195, 196, 196, 196, 196, 196,
+        196, 196, 196, 196, 196, 196, 196, 196, 196, 196, 196, 196, 196, 196, 196, 196, 196, 196, 196, 196, 196, 197,
+        197, 197, 197, 197, 197, 197, 197, 197, 197, 197, 197, 197, 197, 197, 197, 197, 197, 197, 197, 197, 197, 197,
+        197, 197, 197, 198, 198, 198, 198, 198, 198, 198, 198, 198, 198, 198, 198, 198, 198, 198, 198, 198, 198, 198,
+        198, 198, 198, 198, 198, 198, 198, 199, 199, 199, 199, 199, 199, 199, 199, 199, 199, 199, 199, 199, 199, 199,
+        199, 199, 199, 199, 199, 199, 199, 199, 199, 199, 199, 199, 200, 200, 200, 200, 200, 200, 200, 200, 200, 200,
+        200, 200, 200, 200, 200, 200, 200, 200, 200, 200, 200, 200, 200, 200, 200, 200, 201, 201, 201, 201, 201, 201,
+        201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 201, 202,
+        202, 202, 202, 202, 202, 202, 202, 202, 202, 202, 202, 202, 202, 202, 202, 202, 202, 202, 202, 202, 202, 202,
+        202, 202, 202, 202, 203, 203, 203, 203, 203, 203, 203, 203, 203, 203, 203, 203, 203, 203, 203, 203, 203, 203,
+        203, 203, 203, 203, 203, 203, 203, 203, 203, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204,
+        204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 205, 205, 205, 205, 205, 205, 205, 205,
+        205, 205, 205, 205, 205, 205, 205, 205, 205, 205, 205, 205, 205, 205, 205, 205, 205, 205, 205, 205, 206, 206,
+        206, 206, 206, 206, 206, 206, 206, 206, 206, 206, 206, 206, 206, 206, 206, 206, 206, 206, 206, 206, 206, 206,
+        206, 206, 206, 206, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207,
+        207, 207, 207, 207, 207, 207, 207, 207, 207, 208, 208, 208, 208, 208, 208, 208, 208, 208, 208, 208, 208, 208,
+        208, 208, 208, 208, 208, 208, 208, 208, 208, 208, 208, 208, 208, 208, 208, 209, 209, 209, 209, 209, 209, 209,
+        209, 209, 209, 209, 209, 209, 209, 209, 209, 209, 209, 209, 209, 209, 209, 209, 209, 209, 209, 209, 209, 209,
+        210, 210, 210, 210, 210, 210, 210, 210, 210, 210, 210, 210, 210, 210, 210, 210, 210, 210, 210, 210, 210, 210,
+        210, 210, 210, 210, 210, 210, 211, 211, 211, 211, 211, 211, 211, 211, 211, 211, 211, 211, 211, 211, 211, 211,
+        211, 211, 211, 211, 211, 211, 211, 211, 211, 211, 211, 211, 211, 212, 212, 212, 212, 212, 212, 212, 212, 212,
+        212, 212, 212, 212, 212, 212, 212, 212, 212, 212, 212, 212, 212, 212, 212, 212, 212, 212, 212, 213, 213, 213,
+        213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213, 213,
+        213, 213, 213, 213, 214, 214, 214, 214, 214, 214, 214, 214, 214, 214, 214, 214, 214, 214, 214, 214, 214, 214,
+        214, 214, 214, 214, 214, 214, 214, 214, 214, 214, 214, 215, 215, 215, 215, 215, 215, 215, 215, 215, 215, 215,
+        215, 215, 215, 215, 215, 215, 215, 215, 215, 215, 215, 215, 215, 215, 215, 215, 215, 215, 216, 216, 216, 216,
+        216, 216, 216, 216, 216, 216, 216, 216, 216, 216, 216, 216, 216, 216, 216, 216, 216, 216, 216, 216, 216, 216,
+        216, 216, 216, 216, 217, 217, 217, 217, 217, 217, 217, 217, 217, 217, 217, 217, 217, 217, 217, 217, 217, 217,
+        217, 217, 217, 217, 217, 217, 217, 217, 217, 217, 217, 217, 218, 218, 218, 218, 218, 218, 218, 218, 218, 218,
+        218, 218, 218, 218, 218, 218, 218, 218, 218, 218, 218, 218, 218, 218, 218, 218, 218, 218, 218, 219, 219, 219,
+        219, 219, 219, 219, 219, 219, 219, 219, 219, 219, 219, 219, 219, 219, 219, 219, 219, 219, 219, 219, 219, 219,
+        219, 219, 219, 219, 219, 220, 220, 220, 220, 220, 220, 220, 220, 220, 220, 220, 220, 220, 220, 220, 220, 220,
+        220, 220, 220, 220, 220, 220, 220, 220, 220, 220, 220, 220, 220, 221, 221, 221, 221, 221, 221, 221, 221, 221,
+        221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221,
+        222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222, 222,
+        222, 222, 222, 222, 222, 222, 222, 222, 223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 223,
+        223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 223, 224, 224, 224, 224, 224,
+        224, 224, 224, 224, 224, 224, 224, 224, 224, 224, 224, 224, 224, 224, 224, 224, 224, 224, 224, 224, 224, 224,
+        224, 224, 224, 224, 225, 225, 225, 225, 225, 225, 225, 225, 225, 225, 225, 225, 225, 225, 225, 225, 225, 225,
+        225, 225, 225, 225, 225, 225, 225, 225, 225, 225, 225, 225, 225, 226, 226, 226, 226, 226, 226, 226, 226, 226,
+        226, 226, 226, 226, 226, 226, 226, 226, 226, 226, 226, 226, 226, 226, 226, 226, 226, 226, 226, 226, 226, 226,
+        227, 227, 227, 227, 227, 227, 227, 227, 227, 227, 227, 227, 227, 227, 227, 227, 227, 227, 227, 227, 227, 227,
+        227, 227, 227, 227, 227, 227, 227, 227, 227, 228, 228, 228, 228, 228, 228, 228, 228, 228, 228, 228, 228, 228,
+        228, 228, 228, 228, 228, 228, 228, 228, 228, 228, 228, 228, 228, 228, 228, 228, 228, 228, 228, 229, 229, 229,
+        229, 229, 229, 229, 229, 229, 229, 229, 229, 229, 229, 229, 229, 229, 229, 229, 229, 229, 229, 229, 229, 229,
+        229, 229, 229, 229, 229, 229, 229, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230,
+        230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 231, 231, 231, 231, 231,
+        231, 231, 231, 231, 231, 231, 231, 231, 231, 231, 231, 231, 231, 231, 231, 231, 231, 231, 231, 231, 231, 231,
+        231, 231, 231, 231, 231, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232,
+        232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 233, 233, 233, 233, 233, 233, 233,
+        233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233,
+        233, 233, 233, 233, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234,
+        234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 235, 235, 235, 235, 235, 235, 235,
+        235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 235, 235,
+        235, 235, 235, 236, 236, 236, 236, 236, 236, 236, 236, 236, 236, 236, 236, 236, 236, 236, 236, 236, 236, 236,
+        236, 236, 236, 236, 236, 236, 236, 236, 236, 236, 236, 236, 236, 236, 237, 237, 237, 237, 237, 237, 237, 237,
+        237, 237, 237, 237, 237, 237, 237, 237, 237, 237, 237, 237, 237, 237, 237, 237, 237, 237, 237, 237, 237, 237,
+        237, 237, 237, 237, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238,
+        238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 239, 239, 239, 239, 239, 239, 239,
+        239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239, 239,
+        239, 239, 239, 239, 239, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240,
+        240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 240, 241, 241, 241, 241, 241,
+        241, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241, 241,
+        241, 241, 241, 241, 241, 241, 241, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242,
+        242, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242, 242, 243, 243, 243,
+        243, 243, 243, 243, 243, 243, 243, 243, 243, 243, 243, 243, 243, 243, 243, 243, 243, 243, 243, 243, 243, 243,
+        243, 243, 243, 243, 243, 243, 243, 243, 243, 244, 244, 244, 244, 244, 244, 244, 244, 244, 244, 244, 244, 244,
+        244, 244, 244, 244, 244, 244, 244, 244, 244, 244, 244, 244, 244, 244, 244, 244, 244, 244, 244, 244, 244, 244,
+        245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245,
+        245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246,
+        246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246, 246,
+        246, 246, 246, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247,
+        247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 247, 248, 248, 248, 248, 248, 248,
+        248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248,
+        248, 248, 248, 248, 248, 248, 248, 248, 249, 249, 249, 249, 249, 249, 249, 249, 249, 249, 249, 249, 249, 249,
+        249, 249, 249, 249, 249, 249, 249, 249, 249, 249, 249, 249, 249, 249, 249, 249, 249, 249, 249, 249, 249, 250,
+        250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250,
+        250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 250, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251, 251,
+        251, 251, 251, 251, 251, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252,
+        252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 253, 253, 253,
+        253, 253, 253, 253, 253, 253, 253, 253, 253, 253, 253, 253, 253, 253, 253, 253, 253, 253, 253, 253, 253, 253,
+        253, 253, 253, 253, 253, 253, 253, 253, 253, 253, 253, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254,
+        254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254, 254,
+        254, 254, 254, 254};
+
+/// sRGB channel to linear [0, 1]
+static float gamma_decode(const uint8_t channel) { return gammaDecodeTable[channel]; }
+
+/// linear value to sRGB channel, out of gamut values are clamped
+static uint8_t gamma_encode(const float linear)
+{
+  if (not(linear > 0.0f))
+    return 0;
+  if (linear >= 1.0f)
+    return 255;
+  return gammaEncodeTable[static_cast<uint16_t>(linear * (gammaEncodeSize - 1) + 0.5f)];
+}
+
+/// cube root, from an exponent estimation refined by Newton steps
+static float fast_cbrt(const float x)
 {
-  double x = this->x / 100.0;
-  double y = this->y / 100.0;
-  double z = this->z / 100.0;
+  if (x == 0.0f)
+    return 0.0f;
+
+  const float absX = fabsf(x);
+  uint32_t bits;
+  memcpy(&bits, &absX, sizeof(bits));
+  // divide the exponent by 3
+  bits = bits / 3 + 709921077;
+  float y;
+  memcpy(&y, &bits, sizeof(y));
+
+  y = (2.0f * y + absX / (y * y)) / 3.0f;
+  y = (2.0f * y + absX / (y * y)) / 3.0f;
+  y = (2.0f * y + absX / (y * y)) / 3.0f;
+  return (x < 0.0f) ? -y : y;
+}
 
-  double r = x * 3.2404542 + y * -1.5371385 + z * -0.4985314;
-  double g = x * -0.9692660 + y * 1.8760108 + z * 0.0415560;
-  double b = x * 0.0556434 + y * -0.2040259 + z * 1.0572252;
+COLOR XYZ::get_rgb() const
+{
+  const float x = this->x / 100.0f;
+  const float y = this->y / 100.0f;
+  const float z = this->z / 100.0f;
 
-  r = ((r > 0.0031308) ? (1.055 * std::pow(r, 1 / 2.4) - 0.055) : (12.92 * r)) * 255.0;
-  g = ((g > 0.0031308) ? (1.055 * std::pow(g, 1 / 2.4) - 0.055) : (12.92 * g)) * 255.0;
-  b = ((b > 0.0031308) ? (1.055 * std::pow(b, 1 / 2.4) - 0.055) : (12.92 * b)) * 255.0;
+  const float r = x * 3.2404542f + y * -1.5371385f + z * -0.4985314f;
+  const float g = x * -0.9692660f + y * 1.8760108f + z * 0.0415560f;
+  const float b = x * 0.0556434f + y * -0.2040259f + z * 1.0572252f;
 
   COLOR c;
-  c.red = r;
-  c.green = g;
-  c.blue = b;
+  c.red = gamma_encode(r);
+  c.green = gamma_encode(g);
+  c.blue = gamma_encode(b);
   return c;
 }
 
 void XYZ::from_rgb(const COLOR& rgb)
 {
-  double r = rgb.red / 255.0;
-  double g = rgb.green / 255.0;
-  double b = rgb.blue / 255.0;
+  const float r = gamma_decode(rgb.red) * 100.0f;
+  const float g = gamma_decode(rgb.green) * 100.0f;
+  const float b = gamma_decode(rgb.blue) * 100.0f;
 
-  r = ((r > 0.04045) ? std::pow((r + 0.055) / 1.055, 2.4) : (r / 12.92)) * 100.0;
-  g = ((g > 0.04045) ? std::pow((g + 0.055) / 1.055, 2.4) : (g / 12.92)) * 100.0;
-  b = ((b > 0.04045) ? std::pow((b + 0.055) / 1.055, 2.4) : (b / 12.92)) * 100.0;
-
-  this->x = r * 0.4124564 + g * 0.3575761 + b * 0.1804375;
-  this->y = r * 0.2126729 + g * 0.7151522 + b * 0.0721750;
-  this->z = r * 0.0193339 + g * 0.1191920 + b * 0.9503041;
+  this->x = r * 0.4124564f + g * 0.3575761f + b * 0.1804375f;
+  this->y = r * 0.2126729f + g * 0.7151522f + b * 0.0721750f;
+  this->z = r * 0.0193339f + g * 0.1191920f + b * 0.9503041f;
 }
 
 COLOR HSV::get_rgb() const
 {
-  int range = (int)std::floor(this->h / 60.0);
-  double c = this->v * this->s;
-  double x = c * (1 - abs(std::fmod(this->h / 60.0, 2) - 1.0));
-  double m = this->v - c;
+  int range = (int)floorf(this->h / 60.0f);
+  float c = this->v * this->s;
+  float x = c * (1 - fabsf(fmodf(this->h / 60.0f, 2) - 1.0f));
+  float m = this->v - c;
 
   COLOR out;
   switch (range)
@@ -86,16 +348,16 @@ COLOR HSV::get_rgb() const
 
 void HSV::from_rgb(const COLOR& rgb)
 {
-  double r = rgb.red / 255.0;
-  double g = rgb.green / 255.0;
-  double b = rgb.blue / 255.0;
+  float r = rgb.red / 255.0f;
+  float g = rgb.green / 255.0f;
+  float b = rgb.blue / 255.0f;
 
-  double _min = min(r, min(g, b));
-  double _max = max(r, max(g, b));
-  double delta = _max - _min;
+  float _min = min(r, min(g, b));
+  float _max = max(r, max(g, b));
+  float delta = _max - _min;
 
   this->v = _max;
-  this->s = (_max > 1e-3) ? (delta / _max) : 0;
+  this->s = (_max > 1e-3f) ? (delta / _max) : 0;
 
   if (delta == 0)
   {
@@ -117,7 +379,7 @@ void HSV::from_rgb(const COLOR& rgb)
     }
 
     this->h *= 60;
-    this->h = std::fmod(this->h + 360, 360);
+    this->h = fmodf(this->h + 360, 360);
   }
 }
 
@@ -126,17 +388,17 @@ COLOR LAB::get_rgb() const
 {
   const XYZ& white = XYZ::get_white();
 
-  double y = (this->l + 16.0) / 116.0;
-  double x = this->a / 500.0 + y;
-  double z = y - this->b / 200.0;
+  float y = (this->l + 16.0f) / 116.0f;
+  float x = this->a / 500.0f + y;
+  float z = y - this->b / 200.0f;
 
-  double x3 = POW3(x);
-  double y3 = POW3(y);
-  double z3 = POW3(z);
+  const float x3 = POW3(x);
+  const float y3 = POW3(y);
+  const float z3 = POW3(z);
 
-  x = ((x3 > 0.008856) ? x3 : ((x - 16.0 / 116.0) / 7.787)) * white.x;
-  y = ((y3 > 0.008856) ? y3 : ((y - 16.0 / 116.0) / 7.787)) * white.y;
-  z = ((z3 > 0.008856) ? z3 : ((z - 16.0 / 116.0) / 7.787)) * white.z;
+  x = ((x3 > 0.008856f) ? x3 : ((x - 16.0f / 116.0f) / 7.787f)) * white.x;
+  y = ((y3 > 0.008856f) ? y3 : ((y - 16.0f / 116.0f) / 7.787f)) * white.y;
+  z = ((z3 > 0.008856f) ? z3 : ((z - 16.0f / 116.0f) / 7.787f)) * white.z;
 
   XYZ xyz(x, y, z);
   return xyz.get_rgb();
@@ -148,24 +410,24 @@ void LAB::from_rgb(const COLOR& rgb)
 
   XYZ xyz(rgb);
 
-  double x = xyz.x / white.x;
-  double y = xyz.y / white.y;
-  double z = xyz.z / white.z;
+  float x = xyz.x / white.x;
+  float y = xyz.y / white.y;
+  float z = xyz.z / white.z;
 
-  x = (x > 0.008856) ? std::cbrt(x) : (7.787 * x + 16.0 / 116.0);
-  y = (y > 0.008856) ? std::cbrt(y) : (7.787 * y + 16.0 / 116.0);
-  z = (z > 0.008856) ? std::cbrt(z) : (7.787 * z + 16.0 / 116.0);
+  x = (x > 0.008856f) ? fast_cbrt(x) : (7.787f * x + 16.0f / 116.0f);
+  y = (y > 0.008856f) ? fast_cbrt(y) : (7.787f * y + 16.0f / 116.0f);
+  z = (z > 0.008856f) ? fast_cbrt(z) : (7.787f * z + 16.0f / 116.0f);
 
-  this->l = (116.0 * y) - 16;
+  this->l = (116.0f * y) - 16;
   this->a = 500 * (x - y);
   this->b = 200 * (y - z);
 }
 
 COLOR LCH::get_rgb() const
 {
-  const double newH = this->h * c_PI / 180;
+  const float newH = this->h * float(c_PI) / 180;
 
-  LAB lab(this->l, std::cos(newH) * this->c, std::sin(newH) * this->c);
+  LAB lab(this->l, cosf(newH) * this->c, sinf(newH) * this->c);
   return lab.get_rgb();
 }
 
@@ -173,11 +435,11 @@ void LCH::from_rgb(const COLOR& rgb)
 {
   LAB lab(rgb);
 
-  double l = lab.l;
-  double c = std::sqrt(lab.a * lab.a + lab.b * lab.b);
-  double h = std::atan2(lab.b, lab.a);
+  float l = lab.l;
+  float c = sqrtf(lab.a * lab.a + lab.b * lab.b);
+  float h = atan2f(lab.b, lab.a);
 
-  h = h / c_PI * 180;
+  h = h / float(c_PI) * 180;
   if (h < 0)
   {
     h += 360;
@@ -195,42 +457,38 @@ void LCH::from_rgb(const COLOR& rgb)
 // get the rgb form (for display)
 COLOR OKLAB::get_rgb() const
 {
-  double l = this->l + 0.3963377774 * this->a + 0.2158037573 * this->b;
-  double m = this->l - 0.1055613458 * this->a - 0.0638541728 * this->b;
-  double s = this->l - 0.0894841775 * this->a - 1.2914855480 * this->b;
+  float l = this->l + 0.3963377774f * this->a + 0.2158037573f * this->b;
+  float m = this->l - 0.1055613458f * this->a - 0.0638541728f * this->b;
+  float s = this->l - 0.0894841775f * this->a - 1.2914855480f * this->b;
 
   l = l * l * l;
   m = m * m * m;
   s = s * s * s;
 
-  double r = 4.0767245293 * l - 3.3072168827 * m + 0.2307590544 * s;
-  double g = -1.2681437731 * l + 2.6093323231 * m - 0.3411344290 * s;
-  double b = -0.0041119885 * l - 0.7034763098 * m + 1.7068625689 * s;
+  const float r = 4.0767245293f * l - 3.3072168827f * m + 0.2307590544f * s;
+  const float g = -1.2681437731f * l + 2.6093323231f * m - 0.3411344290f * s;
+  const float b = -0.0041119885f * l - 0.7034763098f * m + 1.7068625689f * s;
 
   COLOR out;
-  out.red = ((r > 0.0031308) ? (1.055 * std::pow(r, 1 / 2.4) - 0.055) : (12.92 * r)) * 255.0;
-  out.green = ((g > 0.0031308) ? (1.055 * std::pow(g, 1 / 2.4) - 0.055) : (12.92 * g)) * 255.0;
-  out.blue = ((b > 0.0031308) ? (1.055 * std::pow(b, 1 / 2.4) - 0.055) : (12.92 * b)) * 255.0;
+  out.red = gamma_encode(r);
+  out.green = gamma_encode(g);
+  out.blue = gamma_encode(b);
   return out;
 }
 
 void OKLAB::from_rgb(const COLOR& rgb)
 {
-  double r = rgb.red / 255.0;
-  double g = rgb.green / 255.0;
-  double b = rgb.blue / 255.0;
-
-  r = ((r > 0.04045) ? std::pow((r + 0.055) / 1.055, 2.4) : (r / 12.92));
-  g = ((g > 0.04045) ? std::pow((g + 0.055) / 1.055, 2.4) : (g / 12.92));
-  b = ((b > 0.04045) ? std::pow((b + 0.055) / 1.055, 2.4) : (b / 12.92));
+  const float r = gamma_decode(rgb.red);
+  const float g = gamma_decode(rgb.green);
+  const float b = gamma_decode(rgb.blue);
 
-  double l = 0.4122214708f * r + 0.5363325363f * g + 0.0514459929f * b;
-  double m = 0.2119034982f * r + 0.6806995451f * g + 0.1073969566f * b;
-  double s = 0.0883024619f * r + 0.2817188376f * g + 0.6299787005f * b;
+  float l = 0.4122214708f * r + 0.5363325363f * g + 0.0514459929f * b;
+  float m = 0.2119034982f * r + 0.6806995451f * g + 0.1073969566f * b;
+  float s = 0.0883024619f * r + 0.2817188376f * g + 0.6299787005f * b;
 
-  l = std::cbrt(l);
-  m = std::cbrt(m);
-  s = std::cbrt(s);
+  l = fast_cbrt(l);
+  m = fast_cbrt(m);
+  s = fast_cbrt(s);
 
   this->l = 0.2104542553f * l + 0.7936177850f * m - 0.0040720468f * s;
   this->a = 1.9779984951f * l - 2.4285922050f * m + 0.4505937099f * s;
@@ -239,9 +497,9 @@ void OKLAB::from_rgb(const COLOR& rgb)
 
 COLOR OKLCH::get_rgb() const
 {
-  const double newH = this->h * c_PI / 180;
+  const float newH = this->h * float(c_PI) / 180;
 
-  OKLAB lab(this->l, std::cos(newH) * this->c, std::sin(newH) * this->c);
+  OKLAB lab(this->l, cosf(newH) * this->c, sinf(newH) * this->c);
   return lab.get_rgb();
 }
 
@@ -249,11 +507,11 @@ void OKLCH::from_rgb(const COLOR& rgb)
 {
   OKLAB lab(rgb);
 
-  double l = lab.l;
-  double c = std::sqrt(lab.a * lab.a + lab.b * lab.b);
-  double h = std::atan2(lab.b, lab.a);
+  float l = lab.l;
+  float c = sqrtf(lab.a * lab.a + lab.b * lab.b);
+  float h = atan2f(lab.b, lab.a);
 
-  h = h / c_PI * 180;
+  h = h / float(c_PI) * 180;
   if (h < 0)
   {
     h += 360;
@@ -268,4 +526,4 @@ void OKLCH::from_rgb(const COLOR& rgb)
   this->h = h;
 }
 
-} // namespace utils::ColorSpace
\ No newline at end of file
+} // namespace utils::ColorSpace
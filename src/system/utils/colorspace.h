@@ -15,21 +15,21 @@ class XYZ : public Base
 {
 public:
   XYZ(const COLOR& c) { from_rgb(c); };
-  XYZ(double x, double y, double z) : x(x), y(y), z(z) {};
+  XYZ(float x, float y, float z) : x(x), y(y), z(z) {};
 
   static XYZ get_white()
   {
-    static const XYZ white(95.047, 100.000, 108.883);
+    static const XYZ white(95.047f, 100.000f, 108.883f);
     return white;
   }
 
-  COLOR get_rgb() const override;
+  COLOR get_rgb() const final;
 
   void from_rgb(const COLOR& rgb);
 
-  double x;
-  double y;
-  double z;
+  float x;
+  float y;
+  float z;
 };
 
 class RGB : public Base
@@ -44,7 +44,7 @@ public:
 
   RGB(const uint32_t color) { _color.color = color; }
 
-  COLOR get_rgb() const override { return _color; }
+  COLOR get_rgb() const final { return _color; }
 
 private:
   COLOR _color;
@@ -69,87 +69,112 @@ class HSV : public Base
 {
 public:
   HSV(const COLOR& c) { from_rgb(c); };
-  HSV(double h, double s, double v) : h(h), s(s), v(v) {};
+  HSV(float h, float s, float v) : h(h), s(s), v(v) {};
 
-  COLOR get_rgb() const override;
+  COLOR get_rgb() const final;
 
   void from_rgb(const COLOR& rgb);
 
-  uint16_t get_scaled_hue() const { return h / 360.0 * UINT16_MAX; }
+  uint16_t get_scaled_hue() const { return h / 360.0f * UINT16_MAX; }
 
-  double h;
-  double s;
-  double v;
+  float h;
+  float s;
+  float v;
 };
 
 class LAB : public Base
 {
 public:
   LAB(const COLOR& c) { from_rgb(c); };
-  LAB(const double l, const double a, const double b) : l(l), a(a), b(b) {};
+  LAB(const float l, const float a, const float b) : l(l), a(a), b(b) {};
 
   // get the rgb form (for display)
-  COLOR get_rgb() const override;
+  COLOR get_rgb() const final;
 
   void from_rgb(const COLOR& rgb);
 
-  double l;
-  double a;
-  double b;
+  float l;
+  float a;
+  float b;
 };
 
 class LCH : public Base
 {
 public:
   LCH(const COLOR& c) { from_rgb(c); };
-  LCH(const double l, const double c, const double h) : l(l), c(c), h(h) {};
+  LCH(const float l, const float c, const float h) : l(l), c(c), h(h) {};
 
   // get the rgb form (for display)
-  COLOR get_rgb() const override;
+  COLOR get_rgb() const final;
 
   void from_rgb(const COLOR& rgb);
 
-  uint16_t get_scaled_hue() const { return h / 360.0 * UINT16_MAX; }
+  uint16_t get_scaled_hue() const { return h / 360.0f * UINT16_MAX; }
 
-  double l;
-  double c;
-  double h; // 0 - 360
+  float l;
+  float c;
+  float h; // 0 - 360
 };
 
 class OKLAB : public Base
 {
 public:
   OKLAB(const COLOR& c) { from_rgb(c); };
-  OKLAB(const double l, const double a, const double b) : l(l), a(a), b(b) {};
+  OKLAB(const float l, const float a, const float b) : l(l), a(a), b(b) {};
 
   // get the rgb form (for display)
-  COLOR get_rgb() const override;
+  COLOR get_rgb() const final;
 
   void from_rgb(const COLOR& rgb);
 
-  double l;
-  double a;
-  double b;
+  float l;
+  float a;
+  float b;
 };
 
 class OKLCH : public Base
 {
 public:
   OKLCH(const COLOR& c) { from_rgb(c); };
-  OKLCH(const double l, const double c, const double h) : l(l), c(c), h(h) {};
+  OKLCH(const float l, const float c, const float h) : l(l), c(c), h(h) {};
 
   // get the rgb form (for display)
-  COLOR get_rgb() const override;
+  COLOR get_rgb() const final;
 
   void from_rgb(const COLOR& rgb);
 
-  uint16_t get_scaled_hue() const { return h / 360.0 * UINT16_MAX; }
+  uint16_t get_scaled_hue() const { return h / 360.0f * UINT16_MAX; }
 
-  double l;
-  double c;
-  double h; // 0 - 360
+  float l;
+  float c;
+  float h; // 0 - 360
 };
 
+/**
+ * \brief Convert a span of colors to packed rgb
+ * The conversions are not virtual calls, use this in the per pixel loops
+ */
+template<typename ColorSpaceTy> void convert_span(const ColorSpaceTy* colors, const size_t count, uint32_t* rgb)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    rgb[i] = colors[i].get_rgb().color;
+  }
+}
+
+/**
+ * \brief Convert a span of packed rgb colors to another color space
+ */
+template<typename ColorSpaceTy> void convert_span(const uint32_t* rgb, const size_t count, ColorSpaceTy* colors)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    COLOR c;
+    c.color = rgb[i];
+    colors[i].from_rgb(c);
+  }
+}
+
 } // namespace utils::ColorSpace
 
 #endif
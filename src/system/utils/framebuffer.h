@@ -0,0 +1,222 @@
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+namespace utils {
+
+/**
+ * \brief Packed pixel store of a LED strip, one 0xWWRRGGBB word per LED
+ *
+ * All the span methods clamp their range once, and then run a straight loop
+ * (or a memcpy) over the store: no per-pixel bound checks.
+ * The conversion to the strip wire format is done once, by \p encode
+ *
+ * All writes extend the damaged span (smallest span containing all the pixels
+ * written since the last encode), and only this span is encoded.
+ *
+ * The pixels may be written by one thread while another one encodes them:
+ * the damaged span is a single atomic word, extended after the pixels are
+ * written and swapped out by encode, so no damaged pixel is ever dropped.
+ */
+template<uint16_t ledCount> class FrameBuffer
+{
+public:
+  static constexpr uint16_t size = ledCount;
+
+  /// span of pixels written since the last encode (empty if first >= end)
+  struct DamageTy
+  {
+    uint16_t first;
+    uint16_t end;
+
+    bool is_empty() const { return first >= end; }
+  };
+
+  FrameBuffer() { clear(); }
+
+  const uint32_t* data() const { return _pixels; }
+
+  /**
+   * \brief Direct write access to \p count pixels from \p first
+   * \param[in] writer called with a pointer on the first pixel and the count
+   * of pixels to write, clamped to the end of the store (not called if
+   * empty), the span is marked as damaged once it returns
+   */
+  template<typename WriterTy> void write_span(const uint16_t first, const uint16_t count, WriterTy&& writer)
+  {
+    const uint16_t end = (count == 0) ? first : span_end(first, count);
+    if (end <= first)
+      return;
+    writer(&_pixels[first], static_cast<uint16_t>(end - first));
+    mark_damage(first, end);
+  }
+
+  /// unchecked access, \p n must be lower than size
+  uint32_t get(const uint16_t n) const { return _pixels[n]; }
+  /// unchecked access, \p n must be lower than size
+  void set(const uint16_t n, const uint32_t color)
+  {
+    _pixels[n] = color;
+    mark_damage(n, n + 1);
+  }
+
+  /// set all pixels to black
+  void clear()
+  {
+    memset(_pixels, 0, sizeof(_pixels));
+    mark_damage(0, size);
+  }
+
+  /// span of pixels written since the last encode
+  DamageTy damage() const { return unpack(_damage.load(std::memory_order_relaxed)); }
+
+  /// mark all pixels as damaged, to be encoded again
+  void damage_all() { mark_damage(0, size); }
+
+  /// fill \p count pixels from \p first with \p color (count = 0 means "up to the end")
+  void fill(const uint32_t color, const uint16_t first = 0, const uint16_t count = 0)
+  {
+    const uint16_t end = span_end(first, count);
+    for (uint16_t i = first; i < end; ++i)
+    {
+      _pixels[i] = color;
+    }
+    mark_damage(first, end);
+  }
+
+  /// copy \p count pixels from \p src to the pixels starting at \p first
+  void blit(const uint32_t* src, const uint16_t first, const uint16_t count)
+  {
+    const uint16_t end = span_end(first, count);
+    if (end > first)
+      memcpy(&_pixels[first], src, (end - first) * sizeof(uint32_t));
+    mark_damage(first, end);
+  }
+
+  /// copy \p count pixels from \p src, last one first, to the pixels starting at \p first
+  void blit_reversed(const uint32_t* src, const uint16_t first, const uint16_t count)
+  {
+    const uint16_t end = span_end(first, count);
+    const uint32_t* srcIt = src + (end - first);
+    for (uint16_t i = first; i < end; ++i)
+    {
+      _pixels[i] = *(--srcIt);
+    }
+    mark_damage(first, end);
+  }
+
+  /// copy \p count pixels starting at \p first to \p dst
+  void copy_to(uint32_t* dst, const uint16_t first, const uint16_t count) const
+  {
+    const uint16_t end = span_end(first, count);
+    if (end > first)
+      memcpy(dst, &_pixels[first], (end - first) * sizeof(uint32_t));
+  }
+
+  /// copy a row of \p count pixels from \p srcFirst to \p dstFirst (spans may overlap)
+  void copy_row(const uint16_t srcFirst, const uint16_t dstFirst, uint16_t count)
+  {
+    if (srcFirst >= size or dstFirst >= size)
+      return;
+    const uint16_t maxCount = size - ((srcFirst > dstFirst) ? srcFirst : dstFirst);
+    if (count == 0 or count > maxCount)
+      count = maxCount;
+    memmove(&_pixels[dstFirst], &_pixels[srcFirst], count * sizeof(uint32_t));
+    mark_damage(dstFirst, dstFirst + count);
+  }
+
+  /**
+   * \brief Convert the damaged span to the strip wire format, and clear the damage
+   * \param[in,out] wire the strip byte buffer (3 or 4 bytes per pixel), that
+   * holds the previous encoding of the pixels out of the damaged span
+   * \param[in] rOffset, gOffset, bOffset, wOffset position of each channel in
+   * a pixel. If wOffset == rOffset, the strip has no white channel
+   * \param[in] scale brightness scale, in range 1-256 (256 leaves colors as is)
+   * \return true if at least one byte of \p wire changed
+   */
+  bool encode(uint8_t* wire,
+              const uint8_t rOffset,
+              const uint8_t gOffset,
+              const uint8_t bOffset,
+              const uint8_t wOffset,
+              const uint16_t scale)
+  {
+    // pixels written after the swap are damaged again, for the next encode
+    const DamageTy damage = unpack(_damage.exchange(emptyDamage, std::memory_order_acquire));
+    if (damage.is_empty())
+      return false;
+
+    if (wOffset == rOffset)
+      return encode_pixels<3>(wire, damage, rOffset, gOffset, bOffset, wOffset, scale);
+    return encode_pixels<4>(wire, damage, rOffset, gOffset, bOffset, wOffset, scale);
+  }
+
+private:
+  // damage packed in one word: first in the high half, end in the low half
+  static constexpr uint32_t pack(const uint16_t first, const uint16_t end) { return (uint32_t(first) << 16) | end; }
+  static constexpr DamageTy unpack(const uint32_t packed) { return {uint16_t(packed >> 16), uint16_t(packed & 0xffff)}; }
+  static constexpr uint32_t emptyDamage = pack(size, 0);
+
+  // extend the damaged span, after the pixels were written
+  void mark_damage(const uint16_t first, const uint16_t end)
+  {
+    uint32_t current = _damage.load(std::memory_order_relaxed);
+    while (true)
+    {
+      const DamageTy damage = unpack(current);
+      const uint32_t extended = pack((first < damage.first) ? first : damage.first,
+                                     (end > damage.end) ? end : damage.end);
+      if (extended == current or
+          _damage.compare_exchange_weak(current, extended, std::memory_order_release, std::memory_order_relaxed))
+        return;
+    }
+  }
+
+  uint16_t span_end(const uint16_t first, const uint16_t count) const
+  {
+    if (first >= size)
+      return first;
+    return (count == 0 or count > size - first) ? size : first + count;
+  }
+
+  template<uint8_t bytesPerPixel>
+  bool encode_pixels(uint8_t* wire,
+                     const DamageTy& damage,
+                     const uint8_t rOffset,
+                     const uint8_t gOffset,
+                     const uint8_t bOffset,
+                     const uint8_t wOffset,
+                     const uint16_t scale) const
+  {
+    uint8_t diff = 0;
+    wire += damage.first * bytesPerPixel;
+    for (uint16_t i = damage.first; i < damage.end; ++i, wire += bytesPerPixel)
+    {
+      const uint32_t c = _pixels[i];
+      const uint8_t r = (((c >> 16) & 0xff) * scale) >> 8;
+      const uint8_t g = (((c >> 8) & 0xff) * scale) >> 8;
+      const uint8_t b = ((c & 0xff) * scale) >> 8;
+      diff |= (wire[rOffset] ^ r) | (wire[gOffset] ^ g) | (wire[bOffset] ^ b);
+      wire[rOffset] = r;
+      wire[gOffset] = g;
+      wire[bOffset] = b;
+      if constexpr (bytesPerPixel == 4)
+      {
+        const uint8_t w = ((c >> 24) * scale) >> 8;
+        diff |= wire[wOffset] ^ w;
+        wire[wOffset] = w;
+      }
+    }
+    return diff != 0;
+  }
+
+  alignas(8) uint32_t _pixels[ledCount];
+  std::atomic<uint32_t> _damage = pack(0, size);
+};
+
+} // namespace utils
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef UTILS_FUNCTION_REF_H
+#define UTILS_FUNCTION_REF_H
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+template<typename Signature> class FunctionRef;
+
+/**
+ * \brief Non-owning reference to a callable, without allocation
+ *
+ * Lighter than std::function for callback parameters: it stores a pointer to
+ * the callable (or the function pointer itself) and a call trampoline. The
+ * referenced callable must outlive the FunctionRef, so only use it for
+ * parameters, never to store a callback.
+ */
+template<typename R, typename... Args> class FunctionRef<R(Args...)>
+{
+public:
+  /// reference a free function
+  FunctionRef(R (*function)(Args...)) : trampoline(&call_function) { target.function = function; }
+
+  /// reference a callable object (lambda, functor)
+  template<typename Callable,
+           typename = std::enable_if_t<not std::is_same_v<std::decay_t<Callable>, FunctionRef> and
+                                       std::is_invocable_r_v<R, Callable&, Args...>>>
+  FunctionRef(Callable&& callable) : trampoline(&call_object<std::remove_reference_t<Callable>>)
+  {
+    target.object = const_cast<void*>(static_cast<const void*>(std::addressof(callable)));
+  }
+
+  R operator()(Args... args) const { return trampoline(target, std::forward<Args>(args)...); }
+
+private:
+  union Target
+  {
+    void* object;
+    R (*function)(Args...);
+  };
+
+  static R call_function(const Target target, Args... args) { return target.function(std::forward<Args>(args)...); }
+
+  template<typename Callable> static R call_object(const Target target, Args... args)
+  {
+    return (*static_cast<Callable*>(target.object))(std::forward<Args>(args)...);
+  }
+
+  Target target;
+  R (*trampoline)(Target, Args...);
+};
+
+#endif
@@ -0,0 +1,132 @@
+#include "profiler.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "src/system/utils/print.h"
+
+namespace profiler {
+
+static constexpr uint8_t stageCount = static_cast<uint8_t>(Stage::count);
+
+static const char* const stageNames[stageCount] = {
+        "main loop", "button", "serial", "behavior", "user loop", "show", "alerts"};
+
+struct StageValues
+{
+  uint32_t min_us;
+  uint32_t max_us;
+  uint64_t sum_us;
+  uint32_t count;
+
+  // last durations (saturated to 65ms), written at count % sampleCount
+  uint16_t samples_us[sampleCount];
+};
+
+/**
+ * Stages are recorded from the main thread, except the strip display that
+ * runs on the user thread. Only the recording thread writes the values:
+ * - reset() only requests the recording thread to clear them
+ * - print_stats() copies them, and retries if they were written meanwhile
+ *   (the sequence is odd during a write)
+ */
+struct StageStats
+{
+  std::atomic<uint32_t> sequence;
+  std::atomic<bool> isResetRequested;
+  StageValues values;
+};
+
+static StageStats stats[stageCount];
+
+void record(const Stage stage, const uint32_t duration_us)
+{
+  StageStats& stageStats = stats[static_cast<uint8_t>(stage)];
+  stageStats.sequence.fetch_add(1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  StageValues& values = stageStats.values;
+  if (stageStats.isResetRequested.exchange(false, std::memory_order_relaxed))
+    values.count = 0;
+
+  if (values.count == 0)
+  {
+    values.min_us = duration_us;
+    values.max_us = duration_us;
+    values.sum_us = 0;
+  }
+  values.min_us = std::min(values.min_us, duration_us);
+  values.max_us = std::max(values.max_us, duration_us);
+  values.sum_us += duration_us;
+  values.samples_us[values.count % sampleCount] = static_cast<uint16_t>(std::min<uint32_t>(duration_us, UINT16_MAX));
+  values.count += 1;
+
+  stageStats.sequence.fetch_add(1, std::memory_order_release);
+}
+
+// copy the values of a stage, false if they kept being written
+static bool snapshot(const StageStats& stageStats, StageValues& values)
+{
+  for (uint8_t attempt = 0; attempt < 4; ++attempt)
+  {
+    const uint32_t sequence = stageStats.sequence.load(std::memory_order_acquire);
+    if (sequence % 2 != 0)
+      continue;
+
+    values = stageStats.values;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (stageStats.sequence.load(std::memory_order_relaxed) == sequence)
+    {
+      if (stageStats.isResetRequested.load(std::memory_order_relaxed))
+        values.count = 0;
+      return true;
+    }
+  }
+  return false;
+}
+
+void print_stats()
+{
+  lampda_print("stage: min/avg/p99/max (us), samples");
+  for (uint8_t i = 0; i < stageCount; ++i)
+  {
+    StageValues stageStats;
+    if (not snapshot(stats[i], stageStats))
+    {
+      lampda_print("%s: busy", stageNames[i]);
+      continue;
+    }
+    if (stageStats.count == 0)
+    {
+      lampda_print("%s: no samples", stageNames[i]);
+      continue;
+    }
+
+    // percentile over the last samples only
+    uint16_t sorted[sampleCount];
+    const uint16_t sortedCount = std::min<uint32_t>(stageStats.count, sampleCount);
+    std::copy(stageStats.samples_us, stageStats.samples_us + sortedCount, sorted);
+    std::sort(sorted, sorted + sortedCount);
+    const uint16_t p99 = sorted[(sortedCount * 99) / 100];
+
+    // (lampda_print only formats %d)
+    lampda_print("%s: %d/%d/%d/%d, %d",
+                 stageNames[i],
+                 static_cast<int>(stageStats.min_us),
+                 static_cast<int>(stageStats.sum_us / stageStats.count),
+                 static_cast<int>(p99),
+                 static_cast<int>(stageStats.max_us),
+                 static_cast<int>(stageStats.count));
+  }
+}
+
+void reset()
+{
+  // cleared by the next record(), on the recording thread
+  for (StageStats& stageStats: stats)
+  {
+    stageStats.isResetRequested.store(true, std::memory_order_relaxed);
+  }
+}
+
+} // namespace profiler
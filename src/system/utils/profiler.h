@@ -0,0 +1,69 @@
+#ifndef UTILS_PROFILER_H
+#define UTILS_PROFILER_H
+
+#include <cstdint>
+
+#include "src/system/platform/time.h"
+
+/**
+ * \brief Frame time profiler: duration of each stage of the main loop
+ *
+ * Each stage keeps its min/max/average since the last reset, and the last
+ * sampleCount durations in a ring, to compute a 99th percentile.
+ * Recording a sample is two time_us() calls and a few stores.
+ * A stage must always be recorded from the same thread, print_stats() and
+ * reset() can be called from any thread.
+ */
+namespace profiler {
+
+enum class Stage : uint8_t
+{
+  mainLoop, // whole computation of the main loop
+  button,   // button::handle_events
+  serial,   // serial::handleSerialEvents
+  behavior, // behavior::loop (user loop & alerts included)
+  userLoop, // user::loop, the active mode loop
+  show,     // encoding & output of a changed LED strip frame (user thread)
+  alerts,   // alerts::handle_all
+
+  count // number of stages, keep last
+};
+
+// durations kept for the percentile computation, per stage
+static constexpr uint16_t sampleCount = 128;
+
+/**
+ * \brief Add a duration to the stage statistics
+ */
+void record(const Stage stage, const uint32_t duration_us);
+
+/**
+ * \brief Print the statistics of all stages
+ */
+void print_stats();
+
+/**
+ * \brief Reset the statistics of all stages
+ */
+void reset();
+
+/**
+ * \brief Record the time spent in its scope
+ */
+class ScopedTimer
+{
+public:
+  explicit ScopedTimer(const Stage stage) : _stage(stage), _start_us(time_us()) {}
+  ~ScopedTimer() { record(_stage, time_us() - _start_us); }
+
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+  const Stage _stage;
+  const uint32_t _start_us;
+};
+
+} // namespace profiler
+
+#endif
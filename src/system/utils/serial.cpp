@@ -19,6 +19,7 @@
 #include "src/system/utils/constants.h"
 #include "src/system/utils/utils.h"
 #include "src/system/utils/print.h"
+#include "src/system/utils/profiler.h"
 
 #include "src/system/alerts.h"
 
@@ -50,6 +51,7 @@ void handleCommand(const std::string& command)
                 "format-fs: format the whole file system (dangerous)\n"
                 "DFU: clear this program from memory, enter update mode\n"
                 "tasks: display a debug of task usages\n"
+                "prof: display the loop stage durations, and reset them\n"
                 "-----------------");
         break;
       }
@@ -237,6 +239,11 @@ void handleCommand(const std::string& command)
       lampda_print("%s", buff);
       break;
 
+    case utils::hash("prof"):
+      profiler::print_stats();
+      profiler::reset();
+      break;
+
     default:
       lampda_print("unknown command: %s", command.c_str());
       lampda_print("type h for available commands");
@@ -0,0 +1,54 @@
+#ifndef UTILS_SPSC_RING_H
+#define UTILS_SPSC_RING_H
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * \brief Lock-free ring of blocks, with one producer and any number of readers
+ *
+ * The producer (usually an interrupt) fills write_slot() then publishes it,
+ * which makes it the latest block. Readers borrow the published blocks
+ * without copying: a block is never written while it is one of the last
+ * blockCount - 1 published blocks.
+ *
+ * Blocks are identified by their sequence number, starting at 1.
+ */
+template<typename T, uint8_t blockCount> class SpscRing
+{
+  static_assert(blockCount >= 2, "one block is written while the others are read");
+
+public:
+  // number of published blocks that can be read at the same time
+  static constexpr uint8_t readableCount = blockCount - 1;
+
+  /// (producer) block to fill, not visible to readers until publish()
+  T& write_slot() { return slots[(published.load(std::memory_order_relaxed) + 1) % blockCount]; }
+
+  /// (producer) make the filled write slot the latest block
+  void publish() { published.store(published.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+  /// sequence of the latest published block (0 if none)
+  uint32_t latest_sequence() const { return published.load(std::memory_order_acquire); }
+
+  /// latest published block (a default block if none)
+  const T& latest() const { return slots[latest_sequence() % blockCount]; }
+
+  /// block of a sequence, nullptr if not published yet or overwritten
+  const T* get(const uint32_t sequence) const
+  {
+    const uint32_t latest = latest_sequence();
+    if (sequence == 0 or sequence > latest or latest - sequence >= readableCount)
+      return nullptr;
+    return &slots[sequence % blockCount];
+  }
+
+  /// true if the block of \p sequence was not overwritten since it was borrowed
+  bool is_readable(const uint32_t sequence) const { return latest_sequence() - sequence < readableCount; }
+
+private:
+  T slots[blockCount] = {};
+  std::atomic<uint32_t> published = 0;
+};
+
+#endif
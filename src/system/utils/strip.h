@@ -4,9 +4,10 @@
 // this file is active only if LMBD_LAMP_TYPE=indexable
 #ifdef LMBD_LAMP_TYPE__INDEXABLE
 
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <cstring>
-#include <array>
 
 #ifndef LMBD_SIMULATION
 #include <Adafruit_NeoPixel.h>
@@ -15,8 +16,12 @@
 #endif
 
 #include "src/system/ext/scale8.h"
+#include "src/system/platform/led_output.h"
+#include "src/system/utils/color_kernels.h"
 #include "src/system/utils/constants.h"
 #include "src/system/utils/coordinates.h"
+#include "src/system/utils/framebuffer.h"
+#include "src/system/utils/profiler.h"
 #include "src/system/utils/utils.h"
 #include "src/system/utils/vector_math.h"
 
@@ -34,35 +39,56 @@ struct LampTy;
 class LedStrip : public Adafruit_NeoPixel
 {
   using BufferTy = std::array<uint32_t, LED_COUNT>;
+  using FrameBufferTy = utils::FrameBuffer<LED_COUNT>;
+  using DamageTy = FrameBufferTy::DamageTy;
   friend struct modes::hardware::LampTy;
 
 public:
   LedStrip(int16_t pin, neoPixelType type = NEO_RGB + NEO_KHZ800) : Adafruit_NeoPixel(LED_COUNT, pin, type)
   {
-    COLOR c;
-    c.color = 0;
     for (uint16_t i = 0; i < LED_COUNT; ++i)
     {
-      _colors[i] = c;
-
       lampCoordinates[i] = to_lamp(i);
     }
   }
 
+  void begin()
+  {
+    Adafruit_NeoPixel::begin();
+    isAsyncOutput = led_output_setup(pin, numBytes);
+  }
+
+  // start the display of the changes, only waits if the previous frame is still being sent
   void show()
   {
-    if (hasSomeChanges)
+    // cleared before encoding: a display signaled during the encoding is kept for the next call
+    if (hasSomeChanges.exchange(false))
     {
-      // only show if some changes were made
-      Adafruit_NeoPixel::show();
+      // only the frames to display are timed, not the idle calls
+      const profiler::ScopedTimer timer(profiler::Stage::show);
+      // only show if some changes were made, and the strip output would change
+      if (encode_framebuffer())
+        output();
     }
-    hasSomeChanges = false;
   }
 
+  // display the current colors, and wait for the strip to be updated
   void show_now()
   {
-    Adafruit_NeoPixel::show();
     hasSomeChanges = false;
+    encode_framebuffer();
+    output();
+    wait_for_output();
+  }
+
+  // true while the last frame is still being sent to the strip
+  bool is_output_busy() const { return isAsyncOutput and led_output_is_busy(); }
+
+  // completion fence: wait until the last frame was sent to the strip
+  void wait_for_output() const
+  {
+    if (isAsyncOutput)
+      led_output_wait();
   }
 
   float estimateCurrentDraw()
@@ -74,11 +100,8 @@ public:
 
     for (uint16_t i = 0; i < LED_COUNT; ++i)
     {
-      COLOR c;
-      c.color = getRawPixelColor(i);
-
-      const float res = max(c.blue, max(c.red, c.green));
-      if (res <= 0)
+      // any lit channel (white excluded) draws current
+      if ((_framebuffer.get(i) & 0x00ffffff) == 0)
       {
         continue;
       }
@@ -90,9 +113,7 @@ public:
 
   void setPixelColor(uint16_t n, COLOR c)
   {
-    n = lmpd_constrain(n, 0, LED_COUNT - 1);
-    _colors[n] = c;
-    Adafruit_NeoPixel::setPixelColor(n, c.color);
+    _framebuffer.set(lmpd_constrain(n, 0, LED_COUNT - 1), c.color);
   }
 
   void setPixelColor(uint16_t n, uint8_t r, uint8_t g, uint8_t b)
@@ -128,17 +149,24 @@ public:
 
   void setPixelColorXY(uint16_t x, uint16_t y, uint32_t c) { setPixelColor(to_strip(x, y), c); }
 
+  // fill \p count pixels from \p first (count = 0 means "up to the end"), same as Adafruit_NeoPixel::fill
+  void fill(uint32_t c, uint16_t first = 0, uint16_t count = 0) { _framebuffer.fill(c, first, count); }
+
+  // direct write access to \p count pixels from \p first, \p writer is called with a pointer on the
+  // first pixel and the count of pixels to write (clamped to LED_COUNT)
+  template<typename WriterTy> void write_span(uint16_t first, uint16_t count, WriterTy&& writer)
+  {
+    _framebuffer.write_span(first, count, writer);
+  }
+
   void fadeToBlackBy(const uint8_t fadeBy)
   {
     if (fadeBy == 0)
       return; // optimization - no scaling to apply
 
-    for (uint16_t i = 0; i < LED_COUNT; ++i)
-    {
-      COLOR c;
-      c.color = getPixelColor(i);
-      setPixelColor(i, utils::color_fade(c, 255 - fadeBy));
-    }
+    _framebuffer.write_span(0, LED_COUNT, [fadeBy](uint32_t* out, uint16_t count) {
+      utils::kernels::scale_span(out, count, 255 - fadeBy);
+    });
   }
 
   /*
@@ -169,47 +197,36 @@ public:
   {
     if (blur_amount == 0)
       return; // optimization: 0 means "don't blur"
-    uint8_t keep = 255 - blur_amount;
-    uint8_t seep = blur_amount >> 1;
-    COLOR carryover;
-    carryover.color = 0;
-    for (unsigned i = 0; i < LED_COUNT; i++)
-    {
-      COLOR cur;
-      cur.color = getPixelColor(i);
-      COLOR c = cur;
-      COLOR part = utils::color_fade(c, seep);
-      cur = utils::color_add(utils::color_fade(c, keep), carryover, true);
-      if (i > 0)
-      {
-        c.color = getPixelColor(i - 1);
-        setPixelColor(i - 1, utils::color_add(c, part, true));
-      }
-      setPixelColor(i, cur);
-      carryover = part;
-    }
+
+    _framebuffer.write_span(0, LED_COUNT, [blur_amount](uint32_t* out, uint16_t count) {
+      utils::kernels::blur_span(out, count, blur_amount);
+    });
   }
 
-  uint32_t getPixelColor(uint16_t n) const { return _colors[lmpd_constrain(n, 0, LED_COUNT - 1)].color; }
+  uint32_t getPixelColor(uint16_t n) const { return _framebuffer.get(lmpd_constrain(n, 0, LED_COUNT - 1)); }
   uint32_t getPixelColorXY(int16_t x, int16_t y) const
   {
-    return _colors[lmpd_constrain(to_strip(x, y), 0, LED_COUNT - 1)].color;
+    return _framebuffer.get(lmpd_constrain(to_strip(x, y), 0, LED_COUNT - 1));
   }
 
   // Blends the specified color with the existing pixel color.
   void blendPixelColor(uint16_t n, uint32_t color, uint8_t blend)
   {
-    COLOR c1;
-    c1.color = getPixelColor(n);
-    COLOR c2;
-    c2.color = color;
-    setPixelColor(n, utils::color_blend(c1, c2, blend));
+    n = lmpd_constrain(n, 0, LED_COUNT - 1);
+    _framebuffer.set(n, utils::kernels::blend(_framebuffer.get(n), color, blend));
   }
 
   // Adds the specified color with the existing pixel color perserving color
   // balance.
   void addPixelColor(uint16_t n, uint32_t color, bool fast = false)
   {
+    if (fast)
+    {
+      n = lmpd_constrain(n, 0, LED_COUNT - 1);
+      _framebuffer.set(n, utils::kernels::add(_framebuffer.get(n), color));
+      return;
+    }
+
     COLOR c1;
     c1.color = getPixelColor(n);
     COLOR c2;
@@ -223,22 +240,17 @@ public:
     addPixelColor(to_strip(x, y), color, fast);
   }
 
+  // color as last sent to the strip (brightness applied)
   uint32_t getRawPixelColor(uint16_t n) const { return Adafruit_NeoPixel::getPixelColor(n); }
 
-  void clear()
-  {
-    COLOR c;
-    c.color = 0;
-    for (uint16_t i = 0; i < LED_COUNT; ++i)
-    {
-      _colors[i] = c;
-    }
-    Adafruit_NeoPixel::clear();
-  }
+  void clear() { _framebuffer.clear(); }
 
   // signal the strip that it can display the update
   void signal_display() { hasSomeChanges = true; }
 
+  // span of LEDs written since the last display (empty if nothing was written)
+  DamageTy get_damage() const { return _framebuffer.damage(); }
+
   inline vec3d get_lamp_coordinates(const uint16_t n) const
   {
     return lampCoordinates[lmpd_constrain(n, 0, LED_COUNT - 1)];
@@ -252,17 +264,41 @@ public:
 
   void buffer_current_colors(const uint8_t index)
   {
-    static_assert(sizeof(BufferTy) == sizeof(_colors));
-    memcpy(_buffers[index].data(), _colors, sizeof(_colors));
+    static_assert(sizeof(BufferTy) == sizeof(uint32_t) * FrameBufferTy::size);
+    _framebuffer.copy_to(_buffers[index].data(), 0, LED_COUNT);
+  }
+
+  void fill_buffer(const uint8_t index, const uint32_t value) { _buffers[index].fill(value); }
+
+private:
+  // send the wire format to the strip: the DMA works on its own copy, the next
+  // frame can be rendered and encoded while this one is sent
+  void output()
+  {
+    if (isAsyncOutput and led_output_send(getPixels()))
+      return;
+    // no DMA output available, blocking output
+    Adafruit_NeoPixel::show();
   }
 
-  void fill_buffer(const uint8_t index, const uint32_t value)
+  // convert the damaged LEDs to the wire format, only once per displayed frame
+  // return true if the wire format changed
+  bool encode_framebuffer()
   {
-    memset(_buffers[index].data(), value, sizeof(BufferTy));
+    const uint16_t scale = getBrightness() + 1;
+    const bool isScaleChanged = (scale != encodedScale);
+    if (isScaleChanged)
+    {
+      // all LEDs change (and the wire format may have been rescaled in place)
+      _framebuffer.damage_all();
+      encodedScale = scale;
+    }
+    const bool isWireChanged = _framebuffer.encode(getPixels(), rOffset, gOffset, bOffset, wOffset, scale);
+    return isWireChanged or isScaleChanged;
   }
 
-private:
-  COLOR _colors[LED_COUNT];
+  // packed colors of the strip, before brightness
+  FrameBufferTy _framebuffer;
 
   // buffers for computations
   BufferTy _buffers[stripNbBuffers];
@@ -271,7 +307,12 @@ private:
   vec3d lampCoordinates[LED_COUNT];
 
 private:
-  volatile bool hasSomeChanges;
+  // set by the rendering thread, cleared by the displaying thread
+  std::atomic<bool> hasSomeChanges = false;
+  // brightness scale of the wire format (0 before the first encoding)
+  uint16_t encodedScale = 0;
+  // frames are sent by led_output (set by begin)
+  bool isAsyncOutput = false;
 };
 
 #endif
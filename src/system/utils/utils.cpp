@@ -10,6 +10,7 @@
 #include "src/system/ext/random8.h"
 
 #include "colorspace.h"
+#include "color_kernels.h"
 
 namespace utils {
 
@@ -94,6 +95,12 @@ COLOR color_blend(COLOR color1, COLOR color2, uint16_t blend, bool b16)
   uint16_t blendmax = b16 ? 0xFFFF : 0xFF;
   if (blend == blendmax)
     return color2;
+  if (not b16 and blend < blendmax)
+  {
+    // all channels at once
+    color1.color = kernels::blend(color1.color, color2.color, blend);
+    return color1;
+  }
   uint8_t shift = b16 ? 16 : 8;
 
   COLOR res;
@@ -125,17 +132,11 @@ COLOR color_fade(COLOR c1, uint8_t amount, bool video)
 {
   if (video)
   {
-    c1.red = scale8_video(c1.red, amount);
-    c1.green = scale8_video(c1.green, amount);
-    c1.blue = scale8_video(c1.blue, amount);
-    c1.white = scale8_video(c1.white, amount);
+    c1.color = kernels::scale_video(c1.color, amount);
   }
   else
   {
-    c1.red = scale8(c1.red, amount);
-    c1.green = scale8(c1.green, amount);
-    c1.blue = scale8(c1.blue, amount);
-    c1.white = scale8(c1.white, amount);
+    c1.color = kernels::scale(c1.color, amount);
   }
   return c1;
 }
@@ -144,10 +145,7 @@ COLOR color_add(COLOR c1, COLOR c2, bool fast)
 {
   if (fast)
   {
-    c1.red = qadd8(c1.red, c2.red);
-    c1.green = qadd8(c1.green, c2.green);
-    c1.blue = qadd8(c1.blue, c2.blue);
-    c1.white = qadd8(c1.white, c2.white);
+    c1.color = kernels::add(c1.color, c2.color);
     return c1;
   }
   else
@@ -11,7 +11,16 @@
 // (extern declarations)
 namespace user::_private {
 extern LedStrip strip;
-}
+
+#ifdef LMBD_SIMULATION
+// (simulation only) mode selection, used to benchmark all modes
+uint8_t get_groups_count();
+uint8_t get_modes_count(const uint8_t groupIndex);
+void select_mode(const uint8_t groupIndex, const uint8_t modeIndex);
+// (simulation only) size of the mode state, in the shared mode state arena
+size_t get_mode_state_size(const uint8_t groupIndex, const uint8_t modeIndex);
+#endif
+} // namespace user::_private
 #endif
 
 //